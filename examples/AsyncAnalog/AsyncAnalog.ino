@@ -0,0 +1,75 @@
+/**
+ * An example of sampling a joystick and two potentiometers without
+ * waiting for the ADC, with an AsyncAnalogSampler.
+ *
+ * analogRead() waits about 100us for each conversion on an AVR. Here
+ * each update() collects a finished conversion and starts the next pin's,
+ * so the four pins take turns at the ADC and loop() never waits.
+ *
+ * On boards other than AVRs, AnalogReadAdc is used, which calls
+ * analogRead() so saves no time but runs the same sketch.
+ *
+ * The loop time is printed every few seconds.
+ *
+ */
+#include <EventAnalog.h>
+#include <EventJoystick.h>
+#include "AnalogAdapter/AsyncAnalogSampler.h"
+
+#if defined(__AVR__)
+AvrAsyncAdc adc;
+#else
+AnalogReadAdc adc;
+#endif
+AsyncAnalogSampler sampler(&adc);
+
+EventJoystick joystick(sampler.channel(A0), sampler.channel(A1)); //Change to suit your wiring, must be analog pins
+EventAnalog pot1(sampler.channel(A2));
+EventAnalog pot2(sampler.channel(A3));
+
+uint32_t loops = 0;
+uint32_t reportMs = 0;
+
+void onJoystickEvent(InputEventType et, EventJoystick& ej) {
+  Serial.print("Joystick x: ");
+  Serial.print(ej.x.position());
+  Serial.print(" y: ");
+  Serial.println(ej.y.position());
+}
+
+void onPotEvent(InputEventType et, EventAnalog& ea) {
+  if ( et == InputEventType::CHANGED ) {
+    Serial.print("Pot ");
+    Serial.print(ea.getInputId());
+    Serial.print(": ");
+    Serial.println(ea.position());
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("AsyncAnalog Example");
+  joystick.setCallback(onJoystickEvent);
+  joystick.begin();
+  pot1.setInputId(1);
+  pot1.setCallback(onPotEvent);
+  pot1.begin();
+  pot2.setInputId(2);
+  pot2.setCallback(onPotEvent);
+  pot2.begin();
+}
+
+void loop() {
+  // None of these wait for a conversion
+  joystick.update();
+  pot1.update();
+  pot2.update();
+  loops++;
+  if ( millis() - reportMs >= 5000 ) {
+    Serial.print("Average loop time (us): ");
+    Serial.println((millis() - reportMs) * 1000 / loops);
+    reportMs = millis();
+    loops = 0;
+  }
+}
@@ -0,0 +1,50 @@
+/**
+ * An example of setting a handler for each EventButton event 
+ * instead of a single callback with a switch.
+ * 
+ * There is no DOUBLE_CLICKED or MULTI_CLICKED handler, so CLICKED 
+ * fires as soon as the button is released.
+ *
+ * The button is connected between pin 2 and GND.
+ *
+ */
+#include <EventButton.h>
+
+const uint8_t buttonPin = 2;  // the number of the pushbutton pin
+const uint8_t ledPin = 13;    // the number of the LED pin
+
+EventButton myButton(buttonPin);
+
+void onPressed(InputEventType et, EventButton& eb) {
+  digitalWrite(ledPin, HIGH);
+}
+
+void onReleased(InputEventType et, EventButton& eb) {
+  digitalWrite(ledPin, LOW);
+}
+
+void onClicked(InputEventType et, EventButton& eb) {
+  Serial.println("Clicked");
+}
+
+void onLongClicked(InputEventType et, EventButton& eb) {
+  Serial.print("Long clicked after ");
+  Serial.print(eb.previousDuration());
+  Serial.println("ms");
+}
+
+void setup() {
+  pinMode(ledPin, OUTPUT);
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("EventButton Handlers Example");
+  myButton.begin();
+  myButton.on(InputEventType::PRESSED, onPressed);
+  myButton.on(InputEventType::RELEASED, onReleased);
+  myButton.on(InputEventType::CLICKED, onClicked);
+  myButton.on(InputEventType::LONG_CLICKED, onLongClicked);
+}
+
+void loop() {
+  myButton.update();
+}
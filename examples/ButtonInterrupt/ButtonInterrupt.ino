@@ -0,0 +1,58 @@
+/**
+ * An example of using the EventButton with an InterruptPinAdapter.
+ * 
+ * Edges on the pin are captured (with their time) by an interrupt and 
+ * processed by the next update(), so even though this loop() is very 
+ * slow, short presses are not missed and clicks, double clicks and 
+ * long presses are timed from when the button was actually pressed.
+ *
+ * The button is connected between pin 2 and GND. The pin *must* 
+ * support interrupts (pins 2 and 3 on an UNO).
+ *
+ */
+#include <EventButton.h>
+#include "PinAdapter/InterruptPinAdapter.h"
+
+const uint8_t buttonPin = 2;  // the number of the pushbutton pin (must be an interrupt pin)
+
+InterruptPinAdapter interruptPin(buttonPin);
+EventButton myButton(&interruptPin); // Uses the default debouncer
+
+/**
+ * The interrupt service routine. It must be a plain function that 
+ * calls the adapter's onInterrupt() method.
+ */
+void buttonIsr() {
+  interruptPin.onInterrupt();
+}
+
+/**
+ * A function to handle the events
+ */
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  Serial.print("onButtonEvent: ");
+  Serial.print((uint8_t)et);
+  Serial.print(" clicks: ");
+  Serial.print(eb.clickCount());
+  Serial.print(" previous duration: ");
+  Serial.println(eb.previousDuration());
+}
+
+void setup() {
+  Serial.begin(9600);
+  interruptPin.attach(buttonIsr); // Must be called before begin()
+  myButton.begin();
+  delay(500);
+  Serial.println("EventButton Interrupt Example");
+  myButton.setCallback(onButtonEvent);
+}
+
+void loop() {
+  myButton.update();
+  // Simulate a slow loop, eg a display refresh. Presses during 
+  // this delay are still captured.
+  delay(300);
+  if ( interruptPin.droppedCount() > 0 ) {
+    Serial.println("Some edges were dropped - consider increasing INPUT_EVENTS_EDGE_BUFFER_SIZE");
+  }
+}
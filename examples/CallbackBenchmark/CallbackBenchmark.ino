@@ -0,0 +1,99 @@
+/**
+ * Compares the cost of calling an event callback through a raw 
+ * function pointer, a std::function and the InputDelegate that 
+ * InputEvents uses for its CallbackFunction types.
+ * 
+ * The size of each callback holder and of an EventButton are also 
+ * printed. Build with INPUT_EVENTS_STD_FUNCTION defined to see the 
+ * size of an EventButton using std::function.
+ * 
+ * Requires a board that supports std::function (eg ESP32, Teensy, RP2040).
+ * No wiring is required.
+ *
+ */
+#include <EventButton.h>
+
+#ifndef FUNCTIONAL_SUPPORTED
+#error "This benchmark requires a board that supports std::function"
+#endif
+
+const uint32_t NUM_CALLS = 100000;   // Number of calls timed for each callback type
+
+typedef void (*RawCallback)(InputEventType et, EventButton &eb);
+typedef std::function<void(InputEventType et, EventButton &eb)> StdCallback;
+typedef InputDelegate<void(InputEventType et, EventButton &eb)> DelegateCallback;
+
+EventButton myButton(2);
+
+volatile uint32_t eventCount = 0;
+
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  eventCount++;
+}
+
+/**
+ * A class with a callback method, as used with setCallback(instance, method)
+ */
+class Handler {
+  public:
+  void onButtonEvent(InputEventType et, EventButton& eb) {
+    eventCount++;
+  }
+};
+
+Handler handler;
+
+/**
+ * Time NUM_CALLS calls to the callback. The holder is passed by 
+ * reference so the compiler cannot see (and inline) the target.
+ */
+template <typename C>
+uint32_t timeCalls(C& callback) {
+  uint32_t start = micros();
+  for ( uint32_t i = 0; i < NUM_CALLS; i++ ) {
+    callback(InputEventType::CLICKED, myButton);
+  }
+  return micros() - start;
+}
+
+void printResult(const char* label, uint32_t elapsedUs, size_t size) {
+  Serial.print(label);
+  Serial.print((elapsedUs * 1000UL) / NUM_CALLS);
+  Serial.print("ns per call, ");
+  Serial.print(size);
+  Serial.println(" bytes");
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Callback Benchmark");
+  Serial.print("sizeof(EventButton): ");
+  Serial.println(sizeof(EventButton));
+}
+
+void loop() {
+  Handler* instance = &handler;
+  void (Handler::*method)(InputEventType, EventButton&) = &Handler::onButtonEvent;
+  auto bound = [instance, method](InputEventType et, EventButton& eb) { (instance->*method)(et, eb); };
+
+  RawCallback raw = onButtonEvent;
+  printResult("Function pointer:        ", timeCalls(raw), sizeof(raw));
+
+  StdCallback stdFunction = onButtonEvent;
+  printResult("std::function:           ", timeCalls(stdFunction), sizeof(stdFunction));
+
+  DelegateCallback delegate = onButtonEvent;
+  printResult("InputDelegate:           ", timeCalls(delegate), sizeof(delegate));
+
+  StdCallback stdMethod = bound;
+  printResult("std::function (method):  ", timeCalls(stdMethod), sizeof(stdMethod));
+
+  DelegateCallback delegateMethod = bound;
+  printResult("InputDelegate (method):  ", timeCalls(delegateMethod), sizeof(delegateMethod));
+
+  Serial.print("Events: ");
+  Serial.println(eventCount);
+  Serial.println();
+  delay(3000);
+}
@@ -0,0 +1,93 @@
+/**
+ * An example of using EventChord with three buttons.
+ *
+ * Pressing A and B together (within 50ms) fires the A+B chord
+ * events instead of A's and B's own events. Pressing all three
+ * fires the A+B+C chord. Pressed alone, each button fires its
+ * normal events (A's and B's PRESSED are delayed by up to 50ms).
+ *
+ * The buttons are connected between pins 2, 3 & 4 and GND.
+ *
+ */
+#include <EventChord.h>
+
+EventButton buttonA(2);
+EventButton buttonB(3);
+EventButton buttonC(4);
+
+EventChord chord; // Default chord window is 50ms
+
+int8_t chordAB = -1;
+int8_t chordABC = -1;
+
+/**
+ * Utility function to print the events to Serial.
+ * You don't need this - it's just for the example.
+ */
+void printEvent(InputEventType et) {
+  switch (et) {
+  case InputEventType::PRESSED :
+    Serial.print("PRESSED");
+    break;
+  case InputEventType::RELEASED :
+    Serial.print("RELEASED");
+    break;
+  case InputEventType::CLICKED :
+    Serial.print("CLICKED");
+    break;
+  case InputEventType::DOUBLE_CLICKED :
+    Serial.print("DOUBLE_CLICKED");
+    break;
+  case InputEventType::MULTI_CLICKED :
+    Serial.print("MULTI_CLICKED");
+    break;
+  case InputEventType::LONG_CLICKED :
+    Serial.print("LONG_CLICKED");
+    break;
+  case InputEventType::LONG_PRESS :
+    Serial.print("LONG_PRESS");
+    break;
+  default:
+    Serial.print((uint8_t)et);
+    break;
+  }
+}
+
+/**
+ * Both the chords' and the buttons' events arrive here.
+ */
+void onChordEvent(InputEventType et, EventChord& ec) {
+  if ( ec.member() == &buttonA ) {
+    Serial.print("Button A ");
+  } else if ( ec.member() == &buttonB ) {
+    Serial.print("Button B ");
+  } else if ( ec.member() == &buttonC ) {
+    Serial.print("Button C ");
+  } else if ( ec.chord() == chordAB ) {
+    Serial.print("Chord A+B ");
+  } else if ( ec.chord() == chordABC ) {
+    Serial.print("Chord A+B+C ");
+  } else {
+    Serial.print("Chord input ");
+  }
+  printEvent(et);
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("EventChord Example");
+  chord.addButton(buttonA);
+  chord.addButton(buttonB);
+  chord.addButton(buttonC);
+  chordAB = chord.addChord(buttonA, buttonB);
+  chordABC = chord.addChord(buttonA, buttonB, buttonC);
+  chord.setCallback(onChordEvent);
+  chord.begin(); // Also calls begin() for the buttons
+}
+
+void loop() {
+  // Updates the buttons too - do not call update() for them.
+  chord.update();
+}
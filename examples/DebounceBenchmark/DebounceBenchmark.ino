@@ -0,0 +1,107 @@
+/**
+ * Compares the cost of debouncing N pins with N separate
+ * FoltmanDebounceAdapters (the default debouncer) against one
+ * BankDebounceAdapter64, which debounces every pin of a sample
+ * with a few bitwise operations (vertical counters).
+ *
+ * The bank is timed reading the same VirtualPinAdapters as the
+ * Foltman debouncers, and reading all the pins at once from a
+ * function (as it would from a port register or shift register).
+ *
+ * Results are printed as nanoseconds per pin per sample. The pins
+ * change state every 4th sample so both debouncers have work to do.
+ * The sketch only uses micros(), so it also runs against a
+ * stand-in Arduino core on a PC.
+ *
+ */
+#include <EventButton.h>
+#include "PinAdapter/VirtualPinAdapter.h"
+#include "PinAdapter/FoltmanDebounceAdapter.h"
+#include "PinAdapter/BankDebounceAdapter.h"
+
+const uint8_t MAX_PINS = 64;
+const uint32_t SAMPLES = 2000; // Number of samples of all the pins timed for each result
+
+VirtualPinAdapter pins[MAX_PINS];
+PinAdapter* rawPins[MAX_PINS];
+FoltmanDebounceAdapter* foltman[MAX_PINS];
+
+uint64_t rawMask = 0;
+uint64_t readMask() { return rawMask; }
+
+uint32_t checksum = 0; // Stops the compiler optimising the reads away
+
+void stimulate(uint8_t count, uint32_t sample) {
+  bool state = (sample / 4) & 1;
+  for ( uint8_t i = 0; i < count; i++ ) {
+    pins[i].setState(state);
+  }
+  rawMask = state ? ~(uint64_t)0 : 0;
+}
+
+uint32_t nsPerPin(uint32_t elapsedUs, uint8_t count) {
+  return (uint32_t)(((uint64_t)elapsedUs * 1000) / ((uint64_t)SAMPLES * count));
+}
+
+uint32_t timeFoltman(uint8_t count) {
+  for ( uint8_t i = 0; i < count; i++ ) {
+    foltman[i] = new FoltmanDebounceAdapter(&pins[i]);
+    foltman[i]->setDebounceInterval(10);
+    foltman[i]->begin();
+  }
+  uint32_t start = micros();
+  for ( uint32_t sample = 0; sample < SAMPLES; sample++ ) {
+    stimulate(count, sample);
+    for ( uint8_t i = 0; i < count; i++ ) {
+      checksum += foltman[i]->read(sample * 3);
+    }
+  }
+  uint32_t elapsedUs = micros() - start;
+  for ( uint8_t i = 0; i < count; i++ ) {
+    delete foltman[i];
+  }
+  return nsPerPin(elapsedUs, count);
+}
+
+uint32_t timeBank(BankDebounceAdapter64& bank, uint8_t count) {
+  bank.begin();
+  uint32_t start = micros();
+  for ( uint32_t sample = 0; sample < SAMPLES; sample++ ) {
+    stimulate(count, sample);
+    bank.update(sample * 3);
+    checksum += (uint32_t)bank.debounced();
+  }
+  return nsPerPin(micros() - start, count);
+}
+
+void benchmark(uint8_t count) {
+  BankDebounceAdapter64 pinBank(rawPins, count);
+  BankDebounceAdapter64 maskBank(readMask);
+  Serial.print(count);
+  Serial.print(" pins - Foltman: ");
+  Serial.print(timeFoltman(count));
+  Serial.print("ns bank (PinAdapters): ");
+  Serial.print(timeBank(pinBank, count));
+  Serial.print("ns bank (read function): ");
+  Serial.print(timeBank(maskBank, count));
+  Serial.println("ns per pin");
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Debounce Benchmark");
+  for ( uint8_t i = 0; i < MAX_PINS; i++ ) {
+    rawPins[i] = &pins[i];
+  }
+}
+
+void loop() {
+  for ( uint8_t count = 8; count <= MAX_PINS; count *= 2 ) {
+    benchmark(count);
+  }
+  Serial.print("Checksum: ");
+  Serial.println(checksum);
+  Serial.println();
+  delay(5000);
+}
@@ -0,0 +1,60 @@
+/**
+ * An example of queuing the events from several inputs and handling 
+ * them all in one batch callback, after every input has been updated.
+ * 
+ * A slow handler (here, a deliberately slow print) no longer delays 
+ * the scanning of the inputs updated after the one that fired.
+ *
+ * Buttons are connected between pins 2 & 3 and GND, the switch between
+ * pin 4 and GND.
+ *
+ */
+#include <EventButton.h>
+#include <EventSwitch.h>
+#include <InputRegistry.h>
+
+EventButton button1(2);
+EventButton button2(3);
+EventSwitch mySwitch(4);
+
+EventQueue queue;
+
+/**
+ * The batch callback. Called once by InputRegistry::updateAll() with 
+ * all the events fired during that update.
+ */
+void onEvents(EventQueue& q) {
+  InputEvent e;
+  while ( q.poll(e) ) {
+    Serial.print("Input: ");
+    Serial.print(e.inputId);
+    Serial.print(" event: ");
+    Serial.print((uint8_t)e.type);
+    Serial.print(" at: ");
+    Serial.print(e.ms);
+    Serial.print(" payload: ");
+    Serial.println(e.payload);
+  }
+  if ( q.droppedCount() > 0 ) {
+    Serial.print("Dropped events: ");
+    Serial.println(q.droppedCount());
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("EventQueue Example");
+  InputRegistry::setEventQueue(&queue); // All registered inputs will use the queue
+  queue.setBatchCallback(onEvents);
+  button1.setInputId(1);
+  button2.setInputId(2);
+  mySwitch.setInputId(3);
+  button1.begin();
+  button2.begin();
+  mySwitch.begin();
+}
+
+void loop() {
+  InputRegistry::updateAll(); // Updates all inputs, then calls onEvents()
+}
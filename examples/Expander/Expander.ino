@@ -0,0 +1,51 @@
+/**
+ * An example of reading 16 buttons on an MCP23017 I/O expander with
+ * an ExpanderInputBank. All 16 inputs are read in one I2C transaction,
+ * and only when the expander's interrupt line says a button has changed.
+ *
+ * Wiring:
+ * - MCP23017 SDA and SCL to the Arduino's I2C pins, A0-A2 to GND (address 0x20)
+ * - INTA to pin 2
+ * - Each button between a GPA/GPB pin and GND (the expander's pullups are used)
+ *
+ * Bits 0-7 are GPA0-GPA7 and bits 8-15 are GPB0-GPB7. For a PCF8574,
+ * use a Pcf8574Bus and an ExpanderInputBank8.
+ *
+ */
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/WireExpanderBus.h"
+
+const uint8_t NUM_BUTTONS = 16;
+
+Mcp23017Bus mcp(0x20);
+GpioPinAdapter mcpInterrupt(2); // INTA, active LOW
+ExpanderInputBank expander(&mcp, &mcpInterrupt);
+
+EventButton* buttons[NUM_BUTTONS];
+
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  if ( et == InputEventType::CLICKED ) {
+    Serial.print("Button ");
+    Serial.print(eb.getInputId());
+    Serial.println(" clicked");
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Expander Example");
+  expander.begin();
+  for ( uint8_t i = 0; i < NUM_BUTTONS; i++ ) {
+    buttons[i] = new EventButton(expander.pin(i));
+    buttons[i]->setInputId(i);
+    buttons[i]->setCallback(onButtonEvent);
+    buttons[i]->begin();
+  }
+}
+
+void loop() {
+  // The expander is only read when INTA is LOW (or every 100ms in case an interrupt is missed)
+  InputRegistry::updateAll();
+}
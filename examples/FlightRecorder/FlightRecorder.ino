@@ -0,0 +1,54 @@
+/**
+ * An example of keeping a FlightRecorder running so that, when a 
+ * button 'does not respond', you can see what the pin really did.
+ * 
+ * The raw edges of the button's pin (including contact bounce) are 
+ * recorded by a RecordingPinAdapter. If INPUT_EVENTS_RECORDER is 
+ * defined in your build flags (eg -DINPUT_EVENTS_RECORDER in 
+ * platformio.ini) the button's events are recorded too.
+ * 
+ * Send 'd' over Serial to dump the recording. The edges are in the 
+ * format read by CsvReplaySource, so the dump can be saved and 
+ * replayed with InputReplay.
+ *
+ * The button is connected between pin 2 and GND.
+ *
+ */
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/RecordingPinAdapter.h"
+
+FlightRecorder recorder;
+GpioPinAdapter gpio(2);
+RecordingPinAdapter pin(&gpio, &recorder, 0); // Recorded as channel 0
+EventButton button(&pin);
+
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  Serial.print("Event: ");
+  Serial.println((int)et);
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Flight Recorder Example - send 'd' to dump");
+#ifdef INPUT_EVENTS_RECORDER
+  InputRegistry::setRecorder(&recorder);
+#endif
+  button.setInputId(1);
+  button.begin();
+  button.setCallback(onButtonEvent);
+}
+
+void loop() {
+  InputRegistry::updateAll();
+  if ( Serial.available() && Serial.read() == 'd' ) {
+    recorder.dump(Serial);
+    Serial.print(recorder.entryCount());
+    Serial.print(" entries in ");
+    Serial.print(recorder.bytesUsed());
+    Serial.print(" bytes, ");
+    Serial.print(recorder.overwrittenCount());
+    Serial.println(" overwritten");
+  }
+}
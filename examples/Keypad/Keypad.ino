@@ -0,0 +1,55 @@
+/**
+ * An example of using EventKeypad with a 4x4 membrane keypad.
+ *
+ * The four row pins are connected to 2-5 and the four column
+ * pins to 6-9. Every key fires the same events as an EventButton
+ * (PRESSED, RELEASED, CLICKED, DOUBLE_CLICKED, LONG_PRESS etc).
+ *
+ * A long press on '*' clears the entered code, '#' prints it.
+ *
+ */
+#include <EventKeypad.h>
+
+const uint8_t rowPins[] = { 2, 3, 4, 5 };
+const uint8_t colPins[] = { 6, 7, 8, 9 };
+
+GpioKeypadMatrix matrix(rowPins, 4, colPins, 4);
+EventKeypad keypad(&matrix, "123A456B789C*0#D");
+
+char code[17];
+uint8_t codeLength = 0;
+
+void onKeypadEvent(InputEventType et, EventKeypad& kp) {
+  char key = kp.keyChar();
+  if ( et == InputEventType::CLICKED ) {
+    if ( key == '#' ) {
+      Serial.print("Code: ");
+      Serial.println(code);
+    } else if ( codeLength < sizeof(code) - 1 ) {
+      code[codeLength++] = key;
+      code[codeLength] = 0;
+      Serial.print("Key ");
+      Serial.println(key);
+    }
+  } else if ( et == InputEventType::DOUBLE_CLICKED ) {
+    Serial.print("Double click on key ");
+    Serial.println(key);
+  } else if ( et == InputEventType::LONG_PRESS && key == '*' ) {
+    codeLength = 0;
+    code[0] = 0;
+    Serial.println("Cleared");
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("EventKeypad Example");
+  keypad.setCallback(onKeypadEvent);
+  keypad.begin();
+}
+
+void loop() {
+  // Scans the matrix once and fires the events of every key.
+  keypad.update();
+}
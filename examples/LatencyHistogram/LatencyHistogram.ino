@@ -0,0 +1,59 @@
+/**
+ * An example of measuring the latency from a button press to the 
+ * callback with the latency histograms.
+ * 
+ * The histograms are only compiled in if INPUT_EVENTS_LATENCY is 
+ * defined in your build flags (eg -DINPUT_EVENTS_LATENCY in 
+ * platformio.ini). It must be a build flag - a #define in the sketch 
+ * does not change the library itself.
+ * 
+ * Press and click the button a few times. Every 10 seconds the 
+ * histograms are printed, along with the 99th percentile and the 
+ * number of events that reached their callback within 20ms. 
+ * PRESSED and RELEASED include the debounce interval, CLICKED also 
+ * includes the multi-click wait.
+ *
+ * The button is connected between pin 2 and GND.
+ *
+ */
+#include <EventButton.h>
+#include <InputRegistry.h>
+
+EventButton button(2);
+
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  Serial.print("Event: ");
+  Serial.print((int)et);
+  Serial.print(" latencyUs: ");
+  Serial.println(InputClock::us() - eb.eventTimestamp());
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Latency Histogram Example");
+#ifndef INPUT_EVENTS_LATENCY
+  Serial.println("Define INPUT_EVENTS_LATENCY in your build flags to enable the histograms.");
+#endif
+  button.setInputId(1);
+  button.begin();
+  button.setCallback(onButtonEvent);
+}
+
+void loop() {
+  InputRegistry::updateAll();
+#ifdef INPUT_EVENTS_LATENCY
+  static uint32_t lastPrintMs = 0;
+  if ( millis() - lastPrintMs > 10000 ) {
+    lastPrintMs = millis();
+    InputRegistry::printLatency(Serial);
+    InputLatency& all = InputLatency::global;
+    Serial.print("99th percentile <= ");
+    Serial.print(all.percentileUs(99));
+    Serial.print("us, within 20ms: ");
+    Serial.print(all.countWithin(20000));
+    Serial.print(" of ");
+    Serial.println(all.total());
+  }
+#endif
+}
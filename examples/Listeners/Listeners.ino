@@ -0,0 +1,60 @@
+/**
+ * An example of sending one button's events to several handlers.
+ * 
+ * The button's callback handles the UI, a logger listener receives 
+ * every event and a second listener only receives clicks.
+ *
+ * A button is connected between pin 2 and GND.
+ *
+ */
+#include <EventButton.h>
+
+EventButton myButton(2);
+
+/**
+ * The 'UI' - the button's usual callback.
+ */
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  if ( et == InputEventType::CLICKED ) {
+    Serial.println("UI: Clicked");
+  }
+}
+
+/**
+ * Receives every event from the button.
+ */
+void logEvent(InputEventType et, EventInputBase& input) {
+  Serial.print("Log: input ");
+  Serial.print(input.getInputId());
+  Serial.print(" event ");
+  Serial.println((uint8_t)et);
+}
+
+/**
+ * Only receives click events. The input can be cast to the derived class.
+ */
+void onClicks(InputEventType et, EventInputBase& input) {
+  EventButton& eb = static_cast<EventButton&>(input);
+  Serial.print("Clicks: ");
+  Serial.println(eb.clickCount());
+}
+
+InputListener logger(logEvent);
+InputListener clicks(onClicks, eventMask(InputEventType::CLICKED) 
+                             | eventMask(InputEventType::DOUBLE_CLICKED) 
+                             | eventMask(InputEventType::MULTI_CLICKED));
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Listeners Example");
+  myButton.begin();
+  myButton.setInputId(1);
+  myButton.setCallback(onButtonEvent);
+  myButton.addListener(&logger);
+  myButton.addListener(&clicks);
+}
+
+void loop() {
+  myButton.update();
+}
@@ -0,0 +1,50 @@
+/**
+ * Prints the RAM used by each InputEvents class.
+ * 
+ * Build once as normal and once with INPUT_EVENTS_COMPACT defined 
+ * (eg -DINPUT_EVENTS_COMPACT in your build flags) to compare.
+ * 
+ * No wiring is required.
+ *
+ */
+#include <EventButton.h>
+#include <EventSwitch.h>
+#include <EventAnalog.h>
+#include <EventEncoder.h>
+#include <EventEncoderButton.h>
+#include <EventJoystick.h>
+#include <EventChord.h>
+#include <EventKeypad.h>
+
+void printSize(const char* label, size_t size) {
+  Serial.print(label);
+  Serial.print(": ");
+  Serial.print(size);
+  Serial.println(" bytes");
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+
+#ifdef INPUT_EVENTS_COMPACT
+  Serial.println("Compact mode");
+#else
+  Serial.println("Standard mode");
+#endif
+  printSize("EventButton", sizeof(EventButton));
+  printSize("GpioEventButton", sizeof(GpioEventButton));
+  printSize("EventSwitch", sizeof(EventSwitch));
+  printSize("EventAnalog", sizeof(EventAnalog));
+  printSize("EventEncoder", sizeof(EventEncoder));
+  printSize("EventEncoderButton", sizeof(EventEncoderButton));
+  printSize("EventJoystick", sizeof(EventJoystick));
+  printSize("EventChord", sizeof(EventChord));
+  printSize("EventKeypad", sizeof(EventKeypad)); // Plus a few bytes per key
+  // The default pin and debounce adapters created by EventButton(pin)
+  printSize("GpioPinAdapter", sizeof(GpioPinAdapter));
+  printSize("FoltmanDebounceAdapter", sizeof(FoltmanDebounceAdapter));
+}
+
+void loop() {
+}
@@ -0,0 +1,57 @@
+/**
+ * An example of using the performance counters to find the input 
+ * or callback that is using most of the loop() time.
+ * 
+ * The counters are only compiled in if INPUT_EVENTS_PERF is defined 
+ * in your build flags (eg -DINPUT_EVENTS_PERF in platformio.ini). It 
+ * must be a build flag - a #define in the sketch does not change the 
+ * library itself.
+ * 
+ * Every 5 seconds the counters of each registered input are printed 
+ * and reset.
+ *
+ * Buttons are connected between pins 2 & 3 and GND.
+ *
+ */
+#include <EventButton.h>
+#include <InputRegistry.h>
+
+EventButton fastButton(2);
+EventButton slowButton(3);
+
+void onFastEvent(InputEventType et, EventButton& eb) {
+}
+
+/**
+ * A deliberately slow callback - it will show in callbackMaxUs.
+ */
+void onSlowEvent(InputEventType et, EventButton& eb) {
+  delay(20);
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Performance Counters Example");
+#ifndef INPUT_EVENTS_PERF
+  Serial.println("Define INPUT_EVENTS_PERF in your build flags to enable the counters.");
+#endif
+  fastButton.setInputId(1);
+  slowButton.setInputId(2);
+  fastButton.begin();
+  slowButton.begin();
+  fastButton.setCallback(onFastEvent);
+  slowButton.setCallback(onSlowEvent);
+}
+
+void loop() {
+  InputRegistry::updateAll();
+#ifdef INPUT_EVENTS_PERF
+  static uint32_t lastPrintMs = 0;
+  if ( millis() - lastPrintMs > 5000 ) {
+    lastPrintMs = millis();
+    InputRegistry::printPerf(Serial);
+    InputRegistry::resetPerf();
+  }
+#endif
+}
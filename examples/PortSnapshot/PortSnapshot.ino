@@ -0,0 +1,69 @@
+/**
+ * An example of reading several buttons from one port with a
+ * PortSnapshot, so the port is read once per loop() rather than
+ * once per button.
+ *
+ * On an AVR (eg UNO) the buttons are on pins 2-5 (port D bits 2-5)
+ * and the PIND register is read directly. On other boards the
+ * snapshot is built with digitalRead() by readButtons(), which shows
+ * how any bulk read (a port register, an I/O expander, a test) can
+ * be used.
+ *
+ * Each button is connected between its pin and GND and is debounced
+ * by its default debouncer, as with a pin number.
+ *
+ */
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/PortSnapshot.h"
+
+const uint8_t buttonPins[] = { 2, 3, 4, 5 };
+
+#if defined(PIND)
+PortSnapshot8 port(&PIND);
+const uint8_t firstBit = 2; // Pin 2 is bit 2 of port D
+#else
+uint8_t readButtons() {
+  uint8_t bits = 0;
+  for ( uint8_t i = 0; i < 4; i++ ) {
+    if ( digitalRead(buttonPins[i]) ) bits |= 1 << i;
+  }
+  return bits;
+}
+PortSnapshot8 port(readButtons);
+const uint8_t firstBit = 0;
+#endif
+
+EventButton button0(port.pin(firstBit));
+EventButton button1(port.pin(firstBit + 1));
+EventButton button2(port.pin(firstBit + 2));
+EventButton button3(port.pin(firstBit + 3));
+
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  if ( et == InputEventType::CLICKED ) {
+    Serial.print("Button ");
+    Serial.print(eb.getInputId());
+    Serial.println(" clicked");
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("PortSnapshot Example");
+  // The snapshot pins do not set the pin mode
+  for ( uint8_t pin : buttonPins ) {
+    pinMode(pin, INPUT_PULLUP);
+  }
+  EventButton* buttons[] = { &button0, &button1, &button2, &button3 };
+  for ( uint8_t i = 0; i < 4; i++ ) {
+    buttons[i]->setInputId(i);
+    buttons[i]->setCallback(onButtonEvent);
+    buttons[i]->begin();
+  }
+}
+
+void loop() {
+  // Each update reads the port once for all four buttons
+  InputRegistry::updateAll();
+}
@@ -0,0 +1,86 @@
+/**
+ * Compares the cost of updating a bank of inputs with hand written 
+ * update() calls against a single InputRegistry::updateAll() call.
+ * 
+ * NUM_BUTTONS EventButtons are created with VirtualPinAdapters so no
+ * wiring is required. Every few seconds the time taken for each approach
+ * is printed to Serial as microseconds per loop and nanoseconds per input.
+ * 
+ * Both approaches call update() through a pointer here, so the difference
+ * is the cost of walking the registry's list. What you get in return is 
+ * one line in loop(), however many inputs you add.
+ *
+ */
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/VirtualPinAdapter.h"
+
+const uint16_t NUM_BUTTONS = 80;   // Reduce this for boards with little RAM (eg 16 for an UNO)
+const uint16_t NUM_LOOPS = 1000;   // Number of loops timed for each approach
+
+VirtualPinAdapter* pins[NUM_BUTTONS];
+EventButton* buttons[NUM_BUTTONS];
+
+uint32_t buttonEvents = 0;
+
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  buttonEvents++;
+}
+
+/**
+ * Press or release a few buttons so both approaches do some 
+ * real work rather than just idling.
+ */
+void exercise(uint16_t loopCount) {
+  uint16_t i = loopCount % NUM_BUTTONS;
+  if ( (loopCount / NUM_BUTTONS) % 2 ) {
+    pins[i]->press();
+  } else {
+    pins[i]->release();
+  }
+}
+
+void printResult(const char* label, uint32_t elapsedUs) {
+  Serial.print(label);
+  Serial.print(elapsedUs / NUM_LOOPS);
+  Serial.print("us per loop, ");
+  Serial.print((elapsedUs * 1000UL) / ((uint32_t)NUM_LOOPS * NUM_BUTTONS));
+  Serial.println("ns per input");
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("InputRegistry Benchmark");
+  for ( uint16_t i = 0; i < NUM_BUTTONS; i++ ) {
+    pins[i] = new VirtualPinAdapter();
+    buttons[i] = new EventButton(pins[i], false); // No debouncer for virtual pins
+    buttons[i]->begin(); // Adds the button to the InputRegistry
+    buttons[i]->setCallback(onButtonEvent);
+  }
+  Serial.print(InputRegistry::count());
+  Serial.println(" inputs registered");
+}
+
+void loop() {
+  uint32_t start = micros();
+  for ( uint16_t l = 0; l < NUM_LOOPS; l++ ) {
+    exercise(l);
+    for ( uint16_t i = 0; i < NUM_BUTTONS; i++ ) {
+      buttons[i]->update();
+    }
+  }
+  printResult("Hand written: ", micros() - start);
+
+  start = micros();
+  for ( uint16_t l = 0; l < NUM_LOOPS; l++ ) {
+    exercise(l);
+    InputRegistry::updateAll();
+  }
+  printResult("Registry:     ", micros() - start);
+
+  Serial.print("Events fired: ");
+  Serial.println(buttonEvents);
+  Serial.println();
+  delay(3000);
+}
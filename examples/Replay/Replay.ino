@@ -0,0 +1,76 @@
+/**
+ * An example of replaying a recording of raw pin levels through an
+ * EventButton with InputReplay.
+ * 
+ * The recording is built in memory here: a click with contact bounce,
+ * a double click and a long press. In practice it would be read from
+ * an SD card (see CsvReplaySource) or captured in the field.
+ * 
+ * Each event is printed as ms,inputId,type,payload - save that output 
+ * as a golden file and pass it to setGolden() to check that later 
+ * changes (eg to the debounce interval) give the same events.
+ *
+ * No wiring is required.
+ *
+ */
+#include <EventButton.h>
+#include <InputReplay.h>
+
+InputReplay replay; // Must be created before the button so it starts at simulated time 0
+VirtualPinAdapter pin;
+EventButton button(&pin); // With the default debouncer
+
+uint8_t recording[64];
+size_t recordingLength = 0;
+
+/**
+ * Add a pin level to the recording, deltaMs after the previous one.
+ */
+void record(uint32_t deltaMs, bool level) {
+  recordingLength += BinaryReplaySource::append(recording + recordingLength, 
+                        sizeof(recording) - recordingLength, deltaMs * 1000, 0, level);
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Replay Example");
+
+  // A click with 2ms of bounce on the press
+  record(100, LOW);
+  record(1, HIGH);
+  record(1, LOW);
+  record(120, HIGH);
+  // A double click
+  record(1000, LOW);
+  record(80, HIGH);
+  record(80, LOW);
+  record(80, HIGH);
+  // A long press
+  record(1000, LOW);
+  record(1600, HIGH);
+
+  replay.bindPin(0, &pin); // Channel 0 drives the pin
+  replay.setEventLog(&Serial);
+  button.setInputId(1);
+  button.begin();
+
+  BinaryReplaySource source(recording, recordingLength);
+  ReplayResult result = replay.run(source);
+
+  Serial.print(result.samples);
+  Serial.print(" samples (");
+  Serial.print(recordingLength);
+  Serial.print(" bytes), ");
+  Serial.print(result.events);
+  Serial.print(" events, ");
+  Serial.print(result.updates);
+  Serial.print(" updates for ");
+  Serial.print(result.simulatedMs);
+  Serial.print("ms simulated in ");
+  Serial.print(result.elapsedUs);
+  Serial.println("us");
+}
+
+void loop() {
+}
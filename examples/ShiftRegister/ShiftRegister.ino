@@ -0,0 +1,51 @@
+/**
+ * An example of reading 16 buttons through two chained 74HC165
+ * shift registers with a ShiftRegisterInputBank. The whole chain is
+ * clocked in once per loop(), not once per button.
+ *
+ * Wiring (74HC165 nearest the Arduino):
+ * - SH/LD to pin 8, CLK to pin 9, QH to pin 10
+ * - CLK INH to GND, SER to QH of the second 74HC165
+ * - The second 74HC165 shares SH/LD and CLK, with its SER to GND
+ * - Each input has a 10K pullup and a button to GND
+ *
+ * Bits 0-7 are inputs D0-D7 of the second register and bits 8-15
+ * are D0-D7 of the register nearest the Arduino.
+ *
+ */
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/ShiftRegisterInputBank.h"
+
+const uint8_t NUM_BUTTONS = 16;
+
+GpioShiftRegisterLines lines(8, 9, 10); // SH/LD, CLK, QH
+ShiftRegisterInputBank16 bank(&lines, NUM_BUTTONS);
+
+EventButton* buttons[NUM_BUTTONS];
+
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  if ( et == InputEventType::CLICKED ) {
+    Serial.print("Button ");
+    Serial.print(eb.getInputId());
+    Serial.println(" clicked");
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("ShiftRegister Example");
+  bank.begin();
+  for ( uint8_t i = 0; i < NUM_BUTTONS; i++ ) {
+    buttons[i] = new EventButton(bank.pin(i));
+    buttons[i]->setInputId(i);
+    buttons[i]->setCallback(onButtonEvent);
+    buttons[i]->begin();
+  }
+}
+
+void loop() {
+  // Each update clocks the chain in once for all the buttons
+  InputRegistry::updateAll();
+}
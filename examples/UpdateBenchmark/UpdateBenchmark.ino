@@ -0,0 +1,190 @@
+/**
+ * Measures the cost of update() for each input class, both idle and
+ * under synthetic input, as the number of instances grows from 1 to
+ * MAX_INSTANCES.
+ *
+ * Buttons and switches use VirtualPinAdapters and encoders use
+ * VirtualEncoderAdapters, so no wiring is required. Under input,
+ * every pin is toggled and every encoder stepped before each pass
+ * (the cost of that is included). Analog inputs and joysticks read
+ * A0 (and A1), so their figures are dominated by analogRead().
+ *
+ * "EventButton (GPIO)" and GpioEventButton both read GPIO_PIN through
+ * a GpioPinAdapter and the default FoltmanDebounceAdapter - the first
+ * through virtual calls, the second with the adapters as concrete
+ * types. Under input the pin is toggled with digitalWrite(), which
+ * sets the level read on the host but leaves a board's input pin
+ * idle (so on a board both GPIO figures are for an idle pin).
+ *
+ * Results are printed as nanoseconds per update(). The sketch only
+ * uses millis(), micros(), digitalRead() and analogRead(), so it also
+ * runs on a PC with the host build in extras/host, which raises
+ * MAX_INSTANCES to 10000.
+ *
+ */
+#include <EventButton.h>
+#include <EventSwitch.h>
+#include <EventAnalog.h>
+#include <EventEncoder.h>
+#include <EventEncoderButton.h>
+#include <EventJoystick.h>
+#include <VirtualEncoderAdapter.h>
+#include "PinAdapter/VirtualPinAdapter.h"
+
+#ifndef MAX_INSTANCES
+#define MAX_INSTANCES 100  // Reduce for boards with little RAM (eg 10 for an UNO)
+#endif
+const uint32_t UPDATES_PER_RUN = 20000; // Number of update() calls timed for each result
+const uint8_t GPIO_PIN = 2; // Read by every GPIO button
+
+EventInputBase* inputs[MAX_INSTANCES];
+VirtualPinAdapter* pins[MAX_INSTANCES];
+VirtualEncoderAdapter* encoders[MAX_INSTANCES];
+
+uint32_t eventCount = 0;
+
+void onButtonEvent(InputEventType et, EventButton& ie) { eventCount++; }
+void onGpioButtonEvent(InputEventType et, GpioEventButton& ie) { eventCount++; }
+void onSwitchEvent(InputEventType et, EventSwitch& ie) { eventCount++; }
+void onAnalogEvent(InputEventType et, EventAnalog& ie) { eventCount++; }
+void onEncoderEvent(InputEventType et, EventEncoder& ie) { eventCount++; }
+void onEncoderButtonEvent(InputEventType et, EventEncoderButton& ie) { eventCount++; }
+void onJoystickEvent(InputEventType et, EventJoystick& ie) { eventCount++; }
+
+EventInputBase* createButton(uint16_t i) {
+  pins[i] = new VirtualPinAdapter();
+  EventButton* input = new EventButton(pins[i], false); // No debouncer so every toggle is an event
+  input->setCallback(onButtonEvent);
+  return input;
+}
+
+EventInputBase* createGpioButton(uint16_t i) {
+  EventButton* input = new EventButton(GPIO_PIN); // Virtual GpioPinAdapter and FoltmanDebounceAdapter
+  input->setCallback(onButtonEvent);
+  return input;
+}
+
+EventInputBase* createGpioEventButton(uint16_t i) {
+  GpioEventButton* input = new GpioEventButton(GPIO_PIN); // The same adapters as concrete types
+  input->setCallback(onGpioButtonEvent);
+  return input;
+}
+
+EventInputBase* createSwitch(uint16_t i) {
+  pins[i] = new VirtualPinAdapter();
+  EventSwitch* input = new EventSwitch(pins[i], false);
+  input->setCallback(onSwitchEvent);
+  return input;
+}
+
+EventInputBase* createAnalog(uint16_t i) {
+  EventAnalog* input = new EventAnalog(A0);
+  input->setCallback(onAnalogEvent);
+  return input;
+}
+
+EventInputBase* createEncoder(uint16_t i) {
+  encoders[i] = new VirtualEncoderAdapter();
+  EventEncoder* input = new EventEncoder(encoders[i]);
+  input->setCallback(onEncoderEvent);
+  return input;
+}
+
+EventInputBase* createEncoderButton(uint16_t i) {
+  pins[i] = new VirtualPinAdapter();
+  encoders[i] = new VirtualEncoderAdapter();
+  EventEncoderButton* input = new EventEncoderButton(encoders[i], pins[i], false);
+  input->setCallback(onEncoderButtonEvent);
+  return input;
+}
+
+EventInputBase* createJoystick(uint16_t i) {
+  EventJoystick* input = new EventJoystick(A0, A1);
+  input->setCallback(onJoystickEvent);
+  return input;
+}
+
+struct InputType {
+  const char* name;
+  EventInputBase* (*create)(uint16_t i);
+  bool hasPin;
+  bool hasEncoder;
+  bool hasGpio;
+};
+
+const InputType inputTypes[] = {
+  { "EventButton", createButton, true, false, false },
+  { "EventButton (GPIO)", createGpioButton, false, false, true },
+  { "GpioEventButton", createGpioEventButton, false, false, true },
+  { "EventSwitch", createSwitch, true, false, false },
+  { "EventAnalog", createAnalog, false, false, false },
+  { "EventEncoder", createEncoder, false, true, false },
+  { "EventEncoderButton", createEncoderButton, true, true, false },
+  { "EventJoystick", createJoystick, false, false, false },
+};
+
+/**
+ * Toggle the pins and step the encoders of the first count instances.
+ */
+void stimulate(const InputType& type, uint16_t count, uint32_t pass) {
+  if ( type.hasGpio ) digitalWrite(GPIO_PIN, pass & 1);
+  for ( uint16_t i = 0; i < count; i++ ) {
+    if ( type.hasPin ) pins[i]->setState(pass & 1);
+    if ( type.hasEncoder ) encoders[i]->step();
+  }
+}
+
+/**
+ * Time UPDATES_PER_RUN updates spread over count instances and return nanoseconds per update().
+ */
+uint32_t timeUpdates(const InputType& type, uint16_t count, bool withInput) {
+  uint32_t passes = max(UPDATES_PER_RUN / count, (uint32_t)1);
+  uint32_t start = micros();
+  for ( uint32_t pass = 0; pass < passes; pass++ ) {
+    if ( withInput ) stimulate(type, count, pass);
+    for ( uint16_t i = 0; i < count; i++ ) {
+      inputs[i]->update();
+    }
+  }
+  uint32_t elapsedUs = micros() - start;
+  return (uint32_t)(((uint64_t)elapsedUs * 1000) / (passes * count));
+}
+
+void benchmark(const InputType& type, uint16_t count) {
+  for ( uint16_t i = 0; i < count; i++ ) {
+    inputs[i] = type.create(i);
+    inputs[i]->enableAutoRegister(false); // Not needed, update() is called directly
+    inputs[i]->begin();
+  }
+  Serial.print(type.name);
+  Serial.print(" x");
+  Serial.print(count);
+  Serial.print(" idle: ");
+  Serial.print(timeUpdates(type, count, false));
+  Serial.print("ns input: ");
+  Serial.print(timeUpdates(type, count, true));
+  Serial.println("ns per update()");
+  for ( uint16_t i = 0; i < count; i++ ) {
+    delete inputs[i];
+    if ( type.hasPin ) delete pins[i];
+    if ( type.hasEncoder ) delete encoders[i];
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("Update Benchmark");
+}
+
+void loop() {
+  for ( const InputType& type : inputTypes ) {
+    for ( uint32_t count = 1; count <= MAX_INSTANCES; count *= 10 ) {
+      benchmark(type, count);
+    }
+  }
+  Serial.print("Events fired: ");
+  Serial.println(eventCount);
+  Serial.println();
+  delay(5000);
+}
@@ -0,0 +1,131 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks that inputs built with INPUT_EVENTS_ADAPTER_POOL_SIZE make no heap allocations: the global
+ * operator new is replaced with one that counts, then inputs that create their own adapters are
+ * constructed, given handlers and listeners, updated through presses, key presses and analog changes,
+ * destroyed and constructed again.
+ */
+
+#include <new>
+#include <EventButton.h>
+#include <EventSwitch.h>
+#include <EventAnalog.h>
+#include <EventJoystick.h>
+#include <EventKeypad.h>
+#include <InputListener.h>
+#include <InputRegistry.h>
+#include <AdapterPool.h>
+#include "HostTest.h"
+
+#if INPUT_EVENTS_ADAPTER_POOL_SIZE == 0
+#error "Build with INPUT_EVENTS_ADAPTER_POOL_SIZE greater than 0"
+#endif
+
+using HostTest::check;
+
+namespace {
+    size_t allocations = 0;
+    uint16_t events = 0;
+    uint16_t listened = 0;
+
+    void* countedMalloc(size_t size) {
+        allocations++;
+        return malloc(size ? size : 1);
+    }
+
+    void onButton(InputEventType, EventButton&) { events++; }
+    void onButtonClicked(InputEventType, EventButton&) { events++; }
+    void onSwitch(InputEventType, EventSwitch&) { events++; }
+    void onAnalog(InputEventType, EventAnalog&) { events++; }
+    void onJoystick(InputEventType, EventJoystick&) { events++; }
+    void onKeypad(InputEventType, EventKeypad&) { events++; }
+    void onAnyInput(InputEventType, EventInputBase&) { listened++; }
+
+    /**
+     * Create pool-backed inputs, use them and destroy them. Returns the allocations made.
+     */
+    size_t useInputs() {
+        size_t before = allocations;
+        {
+            EventButton button(2);
+            EventSwitch toggle(3);
+            EventAnalog pot(A0);
+            EventJoystick joystick(A1, A2);
+            VirtualKeypadMatrix matrix(4, 4);
+            EventKeypad keypad(&matrix);
+            InputListener listener(onAnyInput);
+
+            button.setCallback(onButton);
+            button.on(InputEventType::CLICKED, onButtonClicked);
+            button.blockEvent(InputEventType::LONG_PRESS);
+            button.addListener(&listener);
+            toggle.setCallback(onSwitch);
+            pot.setCallback(onAnalog);
+            joystick.setCallback(onJoystick);
+            keypad.setCallback(onKeypad);
+            button.begin();
+            toggle.begin();
+            pot.begin();
+            joystick.begin();
+            keypad.begin();
+
+            for ( uint16_t i = 0; i < 400; i++ ) {
+                FakeArduino::setDigital(2, (i / 20) % 2 ? LOW : HIGH);
+                FakeArduino::setDigital(3, (i / 50) % 2 ? LOW : HIGH);
+                FakeArduino::setAnalog(A0, (i * 7) % 1024);
+                FakeArduino::setAnalog(A1, (i * 13) % 1024);
+                FakeArduino::setAnalog(A2, 1023 - (i * 5) % 1024);
+                matrix.setKey((uint8_t)(i / 30 % 16), (i / 15) % 2);
+                FakeArduino::advanceMillis(5);
+                InputRegistry::updateAll();
+            }
+            check(AdapterPool::available() < AdapterPool::capacity(), "adapters are taken from the pool");
+        }
+        check(AdapterPool::available() == AdapterPool::capacity(), "destroyed inputs return their slots");
+        return allocations - before;
+    }
+}
+
+void* operator new(size_t size) {
+    void* p = countedMalloc(size);
+    if ( !p ) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedMalloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedMalloc(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+#if __cpp_sized_deallocation
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#endif
+
+int main() {
+    // The counter works (volatile so the pair is not optimised away)
+    int* volatile probe = new int(1);
+    delete probe;
+    check(allocations == 1, "operator new is counted");
+
+    FakeArduino::setMicros(0);
+    for ( uint8_t round = 1; round <= 3; round++ ) {
+        size_t made = useInputs();
+        if ( made ) printf("Round %d: %zu allocations\n", round, made);
+        check(made == 0, "no allocations constructing, updating and destroying inputs");
+    }
+    check(events > 0, "inputs fired events");
+    check(listened > 0, "listener was called");
+
+    printf("Pool: %d slots of %d bytes, %d events, %d listener calls, %zu allocations after the probe\n",
+        AdapterPool::capacity(), (int)AdapterPool::SLOT_SIZE, events, listened, allocations - 1);
+    return HostTest::result("Allocations");
+}
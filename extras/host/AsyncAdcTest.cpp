@@ -0,0 +1,120 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks AsyncAnalogSampler round-robin with four EventAnalogs on a SimulatedAsyncAdc: reads never wait for the
+ * ADC, one conversion completes per scan, each pin is sampled in turn, and a change of any pin is reported
+ * within channelCount() + 1 scans (or the equivalent time when the conversion is slower than a scan).
+ */
+
+#include <EventAnalog.h>
+#include <InputRegistry.h>
+#include "AnalogAdapter/AsyncAnalogSampler.h"
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    const uint8_t CHANNELS = 4;
+    const uint8_t PINS[CHANNELS] = { A0, A1, A2, A3 };
+
+    uint8_t changed[CHANNELS];
+
+    void onAnalog(InputEventType et, EventAnalog& ea) {
+        if ( et == InputEventType::CHANGED ) changed[ea.getInputId()]++;
+    }
+
+    // Update once a millisecond, returning how many scans until the input reports a change (0 if it does not)
+    uint16_t scansUntilChanged(uint8_t input, uint16_t maxScans) {
+        uint8_t before = changed[input];
+        for ( uint16_t scan = 1; scan <= maxScans; scan++ ) {
+            FakeArduino::advanceMillis(1);
+            InputRegistry::updateAll();
+            if ( changed[input] != before ) return scan;
+        }
+        return 0;
+    }
+
+    void run(uint16_t ms) {
+        for ( uint16_t i = 0; i < ms; i++ ) {
+            FakeArduino::advanceMillis(1);
+            InputRegistry::updateAll();
+        }
+    }
+
+    /**
+     * The worst latency of a change of each pin, starting at each point of the round-robin.
+     */
+    uint16_t worstLatency(SimulatedAsyncAdc& adc, uint16_t maxScans, bool& allReported) {
+        uint16_t worst = 0;
+        allReported = true;
+        uint16_t level = 1023;
+        for ( uint8_t offset = 0; offset < CHANNELS; offset++ ) {
+            for ( uint8_t i = 0; i < CHANNELS; i++ ) {
+                adc.setValue(PINS[i], level);
+                uint16_t scans = scansUntilChanged(i, maxScans);
+                if ( scans == 0 ) allReported = false;
+                if ( scans > worst ) worst = scans;
+                run(offset + 1); // Move the round-robin on
+            }
+            level = level ? 0 : 1023;
+        }
+        return worst;
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    SimulatedAsyncAdc adc;
+    AsyncAnalogSampler sampler(&adc);
+    EventAnalog* inputs[CHANNELS];
+    for ( uint8_t i = 0; i < CHANNELS; i++ ) {
+        adc.setValue(PINS[i], 512);
+        inputs[i] = new EventAnalog(sampler.channel(PINS[i]));
+        inputs[i]->setInputId(i);
+        inputs[i]->setCallback(onAnalog);
+        inputs[i]->begin();
+    }
+    check(sampler.channelCount() == CHANNELS, "each pin is a channel");
+    check(sampler.channel(A0) == sampler.channel(A0), "a pin has one channel");
+    run(10);
+
+    // One conversion per scan (a conversion is shorter than the 1ms between scans), never waiting
+    uint32_t conversions = sampler.conversionCount();
+    uint32_t us = InputClock::us();
+    InputRegistry::updateAll(); // At the same time as the last scan, so the conversion it started is not ready
+    check(InputClock::us() == us && sampler.conversionCount() == conversions, "a scan does not wait for a conversion");
+    uint32_t starts = adc.startCount();
+    run(100);
+    check(sampler.conversionCount() - conversions == 100 && adc.startCount() - starts == 100,
+        "one conversion completes and the next starts per scan of four inputs");
+
+    // Each pin in turn: a change shows after at most one round of the other pins
+    bool allReported;
+    uint16_t worst = worstLatency(adc, 20, allReported);
+    check(allReported, "a change of every pin is reported");
+    check(worst <= CHANNELS + 1, "a change is reported within channelCount() + 1 scans");
+    printf("%d channels, 104us conversion: a change is reported within %d scans\n", CHANNELS, worst);
+    for ( uint8_t i = 0; i < CHANNELS; i++ ) {
+        check(changed[i] == CHANNELS, "each input reports only its own pin's changes");
+    }
+
+    // A conversion slower than a scan: reads still return at once, with one conversion every three scans
+    adc.setConversionTime(2500);
+    run(10);
+    conversions = sampler.conversionCount();
+    run(300);
+    check(sampler.conversionCount() - conversions == 100, "a 2.5ms conversion completes every third 1ms scan");
+    worst = worstLatency(adc, 50, allReported);
+    check(allReported && worst <= 3 * (CHANNELS + 1), "with a slow conversion a change is reported within channelCount() + 1 conversions");
+    printf("%d channels, 2500us conversion: a change is reported within %d scans\n", CHANNELS, worst);
+
+    for ( uint8_t i = 0; i < CHANNELS; i++ ) delete inputs[i];
+    return HostTest::result("AsyncAnalogSampler");
+}
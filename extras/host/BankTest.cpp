@@ -0,0 +1,139 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks BasicBankDebounceAdapter with eight EventButtons: each raw pin is read once per sample and the clock
+ * once per scan however many buttons read the bank, presses are debounced after four samples and bounces
+ * are ignored.
+ */
+
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/BankDebounceAdapter.h"
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    /**
+     * A raw pin that counts its reads.
+     */
+    class CountingPin : public PinAdapter {
+        public:
+        void begin() {}
+        bool read() {
+            reads++;
+            return level;
+        }
+        bool level = HIGH;
+        uint32_t reads = 0;
+    };
+
+    uint32_t clockReads = 0;
+    uint32_t countedMs() {
+        clockReads++;
+        return millis();
+    }
+
+    const uint8_t BUTTONS = 8;
+    CountingPin raw[BUTTONS];
+    PinAdapter* rawPins[BUTTONS];
+    uint8_t pressed[BUTTONS];
+
+    void onButton(InputEventType et, EventButton& b) {
+        if ( et == InputEventType::PRESSED ) pressed[b.getInputId()]++;
+    }
+
+    uint32_t totalReads() {
+        uint32_t n = 0;
+        for ( uint8_t i = 0; i < BUTTONS; i++ ) n += raw[i].reads;
+        return n;
+    }
+
+    // Update once a millisecond
+    void run(uint16_t ms) {
+        for ( uint16_t i = 0; i < ms; i++ ) {
+            FakeArduino::advanceMillis(1);
+            InputRegistry::updateAll();
+        }
+    }
+
+    uint16_t maskReads = 0;
+    uint8_t maskLevels = 0xFF;
+    uint8_t readMask() {
+        maskReads++;
+        return maskLevels;
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    for ( uint8_t i = 0; i < BUTTONS; i++ ) rawPins[i] = &raw[i];
+    BasicBankDebounceAdapter<uint8_t, BUTTONS> bank(rawPins, BUTTONS);
+    EventButton* buttons[BUTTONS];
+    for ( uint8_t i = 0; i < BUTTONS; i++ ) {
+        buttons[i] = new EventButton(bank.pin(i), false);
+        buttons[i]->setInputId(i);
+        buttons[i]->setCallback(onButton);
+        buttons[i]->begin();
+    }
+    check(bank.pin(BUTTONS) == nullptr, "a bank has a pin for each of its PinCount bits");
+    run(100);
+
+    // Scans
+    uint32_t reads = totalReads();
+    InputClock::setSource(countedMs);
+    run(30);
+    InputClock::resetSource();
+    check(totalReads() - reads == 10 * BUTTONS, "each raw pin is read once per sample (every 3ms)");
+    check(clockReads == 30 * 2, "the clock is read once per scan by the registry and once by the bank");
+    for ( uint8_t i = 0; i < BUTTONS; i++ ) {
+        check(raw[i].reads == raw[0].reads, "every raw pin is read the same number of times");
+    }
+
+    // Debounce
+    raw[2].level = LOW;
+    raw[5].level = LOW;
+    run(8);
+    check(pressed[2] == 0 && pressed[5] == 0, "a press is held back for four samples");
+    run(5);
+    check(pressed[2] == 1 && pressed[5] == 1, "pins pressed together are debounced together");
+    check(buttons[2]->isPressed() && !buttons[3]->isPressed(), "only the pressed pins are pressed");
+    raw[2].level = HIGH;
+    raw[5].level = HIGH;
+    run(20);
+    check(!buttons[2]->isPressed() && !buttons[5]->isPressed(), "a release is debounced");
+
+    // A bounce shorter than four samples
+    for ( uint8_t i = 0; i < 5; i++ ) {
+        raw[7].level = LOW;
+        run(4);
+        raw[7].level = HIGH;
+        run(3);
+    }
+    run(20);
+    check(pressed[7] == 0, "a bouncing pin that never settles is not pressed");
+
+    for ( uint8_t i = 0; i < BUTTONS; i++ ) delete buttons[i];
+
+    // A bank read through a function
+    BasicBankDebounceAdapter<uint8_t> masked(readMask);
+    EventButton a(masked.pin(0), false);
+    EventButton b(masked.pin(7), false);
+    a.begin();
+    b.begin();
+    maskReads = 0;
+    run(30);
+    check(maskReads == 10, "the read function is called once per sample for all the pins");
+    maskLevels = 0x7F;
+    run(15);
+    check(b.isPressed() && !a.isPressed(), "a pin read through the function is debounced");
+
+    return HostTest::result("BankDebounceAdapter");
+}
@@ -0,0 +1,8 @@
+// Runs examples/CallbackBenchmark once on the host: function pointer, std::function and InputDelegate calls
+#include "../../examples/CallbackBenchmark/CallbackBenchmark.ino"
+
+int main() {
+    setup();
+    loop();
+    return eventCount == 5 * NUM_CALLS ? 0 : 1; // Every call must have reached its target
+}
@@ -0,0 +1,307 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks EventChord with three buttons and the chords A+B and A+B+C: a chord fires its own events instead of
+ * its members' (whose presses, releases, long presses and clicks are suppressed), a button pressed alone
+ * fires its normal events once the chord window has passed, a click straight after a chord is not swallowed,
+ * and a smaller chord waits for a larger one. Buttons and chords destroyed in either order are detached
+ * safely and the buttons are registered again.
+ */
+
+#include <EventChord.h>
+#include <InputRegistry.h>
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    const uint8_t PIN_A = 2;
+    const uint8_t PIN_B = 3;
+    const uint8_t PIN_C = 4;
+
+    struct ChordEvent {
+        InputEventType et;
+        int8_t chord;
+        int8_t member; // -1 for a chord event
+    };
+
+    ChordEvent events[64];
+    uint8_t eventCount = 0;
+
+    EventButton buttonA(PIN_A);
+    EventButton buttonB(PIN_B);
+    EventButton buttonC(PIN_C);
+    EventButton* buttons[] = { &buttonA, &buttonB, &buttonC };
+    EventChord chord;
+    int8_t chordAB = -1;
+    int8_t chordABC = -1;
+
+    void onChord(InputEventType et, EventChord& ec) {
+        int8_t member = -1;
+        for ( int8_t i = 0; i < 3; i++ ) {
+            if ( ec.member() == buttons[i] ) member = i;
+        }
+        if ( eventCount < 64 ) events[eventCount++] = { et, ec.chord(), member };
+    }
+
+    uint8_t countChord(InputEventType et, int8_t c) {
+        uint8_t n = 0;
+        for ( uint8_t i = 0; i < eventCount; i++ ) {
+            if ( events[i].et == et && events[i].member < 0 && events[i].chord == c ) n++;
+        }
+        return n;
+    }
+
+    uint8_t countMember(InputEventType et, int8_t member) {
+        uint8_t n = 0;
+        for ( uint8_t i = 0; i < eventCount; i++ ) {
+            if ( events[i].et == et && events[i].member == member ) n++;
+        }
+        return n;
+    }
+
+    uint8_t countMemberEvents() {
+        uint8_t n = 0;
+        for ( uint8_t i = 0; i < eventCount; i++ ) {
+            if ( events[i].member >= 0 ) n++;
+        }
+        return n;
+    }
+
+    // Update once a millisecond
+    void run(uint16_t ms) {
+        for ( uint16_t i = 0; i < ms; i++ ) {
+            FakeArduino::advanceMillis(1);
+            InputRegistry::updateAll();
+        }
+    }
+
+    void press(uint8_t pin) { FakeArduino::setDigital(pin, LOW); }
+    void release(uint8_t pin) { FakeArduino::setDigital(pin, HIGH); }
+
+    void settle() {
+        release(PIN_A);
+        release(PIN_B);
+        release(PIN_C);
+        run(1000);
+        eventCount = 0;
+    }
+
+    void chordClick() {
+        press(PIN_A);
+        run(20);
+        press(PIN_B);
+        run(100);
+        check(countChord(InputEventType::PRESSED, chordAB) == 1, "pressing A and B within the window fires the chord's PRESSED");
+        check(chord.pressedChord() == chordAB, "the chord is pressed");
+        release(PIN_A);
+        run(20);
+        check(countChord(InputEventType::RELEASED, chordAB) == 1 && countChord(InputEventType::CLICKED, chordAB) == 1,
+            "releasing a member fires the chord's RELEASED and CLICKED");
+        check(chord.pressedChord() == -1, "the chord is released");
+        release(PIN_B);
+        run(1000);
+        check(countMemberEvents() == 0, "the members of a chord fire no events of their own");
+        settle();
+    }
+
+    void clickAfterChord() {
+        press(PIN_A);
+        press(PIN_B);
+        run(100);
+        release(PIN_A);
+        release(PIN_B);
+        run(60);
+        // Inside the multi click interval of the chord's release
+        press(PIN_A);
+        run(60);
+        release(PIN_A);
+        run(1000);
+        check(countChord(InputEventType::CLICKED, chordAB) == 1, "the chord clicks");
+        check(countMember(InputEventType::PRESSED, 0) == 1 && countMember(InputEventType::RELEASED, 0) == 1,
+            "a press straight after a chord fires PRESSED and RELEASED");
+        check(countMember(InputEventType::CLICKED, 0) == 1 && countMember(InputEventType::DOUBLE_CLICKED, 0) == 0,
+            "a click straight after a chord fires CLICKED (the chord is not one of its clicks)");
+        check(countMemberEvents() == 3 && countMember(InputEventType::PRESSED, 1) == 0, "the chord's own presses fire nothing");
+        settle();
+    }
+
+    void chordLongClick() {
+        press(PIN_A);
+        press(PIN_B);
+        run(1500);
+        check(countChord(InputEventType::PRESSED, chordAB) == 1, "a held chord fires PRESSED");
+        check(countMember(InputEventType::LONG_PRESS, 0) == 0 && countMember(InputEventType::LONG_PRESS, 1) == 0,
+            "the members of a held chord fire no LONG_PRESS");
+        release(PIN_B);
+        run(20);
+        release(PIN_A);
+        run(1000);
+        check(countChord(InputEventType::LONG_CLICKED, chordAB) == 1 && countChord(InputEventType::CLICKED, chordAB) == 0,
+            "releasing a held chord fires LONG_CLICKED");
+        check(countMemberEvents() == 0, "the members of a held chord fire no events of their own");
+        settle();
+    }
+
+    void largerChord() {
+        press(PIN_A);
+        press(PIN_B);
+        run(20);
+        check(countChord(InputEventType::PRESSED, chordAB) == 0, "A+B waits for the window in case C is pressed");
+        press(PIN_C);
+        run(40);
+        check(countChord(InputEventType::PRESSED, chordABC) == 1 && countChord(InputEventType::PRESSED, chordAB) == 0,
+            "pressing C within the window fires A+B+C instead of A+B");
+        release(PIN_C);
+        run(20);
+        check(countChord(InputEventType::CLICKED, chordABC) == 1, "releasing a member of A+B+C clicks it");
+        settle();
+        check(eventCount == 0, "nothing fires after the chord");
+
+        press(PIN_A);
+        press(PIN_B);
+        run(49);
+        check(countChord(InputEventType::PRESSED, chordAB) == 0, "A+B is held back for the window");
+        run(20);
+        check(countChord(InputEventType::PRESSED, chordAB) == 1, "A+B fires when the window closes");
+        settle();
+    }
+
+    /**
+     * Buttons and chords in a local scope, destroyed in either order.
+     */
+    void destroyOrder() {
+        uint16_t registered = InputRegistry::count();
+        {
+            EventButton a(PIN_A);
+            EventButton b(PIN_B);
+            a.begin(); // Registered before it is added
+            EventChord local;
+            local.addButton(a);
+            local.addButton(b);
+            local.addChord(a, b);
+            local.begin();
+            check(!InputRegistry::contains(&a) && !InputRegistry::contains(&b) && InputRegistry::contains(&local),
+                "the chord takes over the registration of its buttons");
+            check(local.addButton(a) == -1, "a button cannot be added twice");
+        }
+        check(InputRegistry::count() == registered, "the buttons and chord are unregistered when destroyed");
+
+        {
+            EventButton a(PIN_A);
+            EventButton b(PIN_B);
+            b.enableAutoRegister(false);
+            {
+                EventChord local;
+                local.addButton(a);
+                local.addButton(b);
+                local.begin();
+            }
+            check(InputRegistry::contains(&a) && a.isAutoRegisterEnabled(), "a button is registered again when its chord is destroyed");
+            check(!InputRegistry::contains(&b) && !b.isAutoRegisterEnabled(), "a button that was not auto registering is left alone");
+            check(!a.hasListeners(), "the chord stops listening to its buttons when destroyed");
+            press(PIN_A);
+            run(20);
+            check(a.isPressed(), "the registry updates a button after its chord is destroyed");
+            release(PIN_A);
+            run(1000);
+        }
+        check(InputRegistry::count() == registered, "the buttons are unregistered when destroyed");
+
+        EventChord outer;
+        outer.setCallback(onChord);
+        {
+            EventButton a(PIN_A);
+            EventButton b(PIN_B);
+            outer.addButton(a);
+            outer.addButton(b);
+            outer.addChord(a, b);
+            outer.begin();
+            press(PIN_A);
+            press(PIN_B);
+            run(100);
+            check(outer.pressedChord() == 0, "a local chord is pressed");
+        }
+        // The buttons were destroyed with the chord pressed
+        run(100);
+        check(outer.pressedChord() == -1 && outer.pressedMask() == 0, "a chord whose buttons are destroyed is released");
+        outer.update();
+        check(outer.nextDeadlineMs() != 0, "a chord whose buttons are destroyed is not due");
+        settle();
+    }
+
+    void buttonsAlone() {
+        press(PIN_A);
+        run(40);
+        check(countMember(InputEventType::PRESSED, 0) == 0, "a member's PRESSED is held back for the window");
+        run(40);
+        check(countMember(InputEventType::PRESSED, 0) == 1, "a member pressed alone fires PRESSED after the window");
+        release(PIN_A);
+        run(1000);
+        check(countMember(InputEventType::RELEASED, 0) == 1 && countMember(InputEventType::CLICKED, 0) == 1,
+            "a member pressed alone fires RELEASED and CLICKED");
+        settle();
+
+        // A quick click ends the window early
+        press(PIN_B);
+        run(20);
+        release(PIN_B);
+        run(20);
+        check(countMember(InputEventType::PRESSED, 1) == 1 && countMember(InputEventType::RELEASED, 1) == 1,
+            "a click shorter than the window fires PRESSED and RELEASED");
+        run(1000);
+        check(countMember(InputEventType::CLICKED, 1) == 1, "a click shorter than the window fires CLICKED");
+        settle();
+
+        // Two clicks of one button
+        for ( uint8_t i = 0; i < 2; i++ ) {
+            press(PIN_C);
+            run(80);
+            release(PIN_C);
+            run(80);
+        }
+        run(1000);
+        check(countMember(InputEventType::DOUBLE_CLICKED, 2) == 1, "a member pressed alone fires DOUBLE_CLICKED");
+        settle();
+
+        // A press too late for the window
+        press(PIN_A);
+        run(100);
+        press(PIN_B);
+        run(100);
+        check(chord.pressedChord() == -1 && countChord(InputEventType::PRESSED, chordAB) == 0, "a press after the window is not a chord");
+        check(countMember(InputEventType::PRESSED, 0) == 1 && countMember(InputEventType::PRESSED, 1) == 1, "both buttons fire PRESSED");
+        settle();
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    for ( uint8_t pin : { PIN_A, PIN_B, PIN_C } ) release(pin);
+    chord.addButton(buttonA);
+    chord.addButton(buttonB);
+    chord.addButton(buttonC);
+    chordAB = chord.addChord(buttonA, buttonB);
+    chordABC = chord.addChord(buttonA, buttonB, buttonC);
+    chord.setCallback(onChord);
+    chord.begin();
+    check(chordAB == 0 && chordABC == 1, "chords are numbered from 0");
+    check(InputRegistry::count() == 1, "only the chord is registered");
+    settle();
+
+    chordClick();
+    clickAfterChord();
+    chordLongClick();
+    largerChord();
+    buttonsAlone();
+    destroyOrder();
+
+    return HostTest::result("EventChord");
+}
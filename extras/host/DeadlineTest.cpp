@@ -0,0 +1,93 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks that rate limited EventAnalog and EventEncoder inputs only report a deadline while a change is held
+ * back by the rate limit, so an idle input can sleep until its IDLE event.
+ */
+
+#include <EventAnalog.h>
+#include <EventEncoder.h>
+#include <VirtualEncoderAdapter.h>
+#include "AnalogAdapter/VirtualAnalogAdapter.h"
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    uint8_t changes = 0;
+
+    void onAnalog(InputEventType et, EventAnalog&) { if ( et == InputEventType::CHANGED ) changes++; }
+    void onEncoder(InputEventType et, EventEncoder&) { if ( et == InputEventType::CHANGED ) changes++; }
+
+    void analogDeadline() {
+        VirtualAnalogAdapter pot;
+        pot.setValue(512);
+        EventAnalog analog(&pot);
+        analog.setCallback(onAnalog);
+        analog.setRateLimit(100);
+        analog.setIdleTimeout(60000);
+        analog.begin();
+        analog.update();
+        for ( uint8_t i = 0; i < 200; i++ ) {
+            FakeArduino::advanceMillis(1);
+            analog.update();
+        }
+        check(analog.nextDeadlineMs() > 100, "an idle rate limited analog has no rate limit deadline");
+
+        changes = 0;
+        pot.setValue(900);
+        analog.update();
+        check(changes == 1, "the first change after a rate limit window has passed is reported at once");
+        FakeArduino::advanceMillis(10);
+        pot.setValue(100);
+        analog.update();
+        check(changes == 1, "a change within the rate limit window is held back");
+        check(analog.nextDeadlineMs() == 91, "a held back change is due at the end of the window");
+        FakeArduino::advanceMillis(91);
+        analog.update();
+        check(changes == 2 && analog.nextDeadlineMs() > 100, "a held back change is reported at the end of the window");
+    }
+
+    void encoderDeadline() {
+        VirtualEncoderAdapter knob;
+        EventEncoder encoder(&knob);
+        encoder.setCallback(onEncoder);
+        encoder.setRateLimit(50);
+        encoder.setIdleTimeout(60000);
+        encoder.begin();
+        for ( uint8_t i = 0; i < 100; i++ ) {
+            FakeArduino::advanceMillis(1);
+            encoder.update();
+        }
+        check(encoder.nextDeadlineMs() > 50, "an idle rate limited encoder has no rate limit deadline");
+
+        changes = 0;
+        knob.step(4);
+        check(encoder.nextDeadlineMs() <= 51, "a turn not yet read is due by the end of the window");
+        FakeArduino::advanceMillis(51);
+        encoder.update();
+        check(changes == 1 && encoder.nextDeadlineMs() > 50, "a turn is reported and then nothing is due");
+
+        // Without a rate limit, a turn in the same millisecond as the last update is due in the next one
+        encoder.setRateLimit(0);
+        knob.step(4);
+        check(encoder.nextDeadlineMs() == 1, "an unreported turn is due in the next millisecond");
+        FakeArduino::advanceMillis(1);
+        encoder.update();
+        check(changes == 2 && encoder.nextDeadlineMs() > 50, "the turn is reported");
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    analogDeadline();
+    encoderDeadline();
+    return HostTest::result("Deadlines");
+}
@@ -0,0 +1,8 @@
+// Runs examples/DebounceBenchmark once on the host: FoltmanDebounceAdapters against a BankDebounceAdapter64
+#include "../../examples/DebounceBenchmark/DebounceBenchmark.ino"
+
+int main() {
+    setup();
+    loop();
+    return checksum > 0 ? 0 : 1; // The debouncers must have seen the pins change
+}
@@ -0,0 +1,110 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks BasicExpanderInputBank against a VirtualExpanderBus with sixteen EventButtons: with the interrupt
+ * line the bus is not read while the line is idle (except after the timeout) and is read once when it is
+ * asserted, and without it the bus is read once per read interval however many buttons read it.
+ */
+
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/ExpanderInputBank.h"
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    const uint8_t INPUTS = 16;
+
+    // Update once a millisecond
+    void run(uint16_t ms) {
+        for ( uint16_t i = 0; i < ms; i++ ) {
+            FakeArduino::advanceMillis(1);
+            InputRegistry::updateAll();
+        }
+    }
+
+    uint8_t pressedCount(EventButton** buttons) {
+        uint8_t n = 0;
+        for ( uint8_t i = 0; i < INPUTS; i++ ) if ( buttons[i]->isPressed() ) n++;
+        return n;
+    }
+
+    void interruptGated() {
+        VirtualExpanderBus bus;
+        ExpanderInputBank expander(&bus, bus.interruptPin(), 100);
+        expander.begin();
+        EventButton* buttons[INPUTS];
+        for ( uint8_t i = 0; i < INPUTS; i++ ) {
+            buttons[i] = new EventButton(expander.pin(i));
+            buttons[i]->begin();
+        }
+        run(150);
+
+        // Idle: only the timeout reads the bus
+        uint32_t reads = bus.readCount();
+        while ( bus.readCount() == reads ) run(1); // Up to the next timeout
+        reads = bus.readCount();
+        check(expander.busReadCount() == reads, "busReadCount() counts the bus reads");
+        run(99);
+        check(bus.readCount() == reads, "the bus is not read while the interrupt line is idle");
+        run(1);
+        check(bus.readCount() == reads + 1, "the bus is read when the timeout passes");
+        reads = bus.readCount();
+        run(1000);
+        check(bus.readCount() - reads == 10, "an idle expander is read once per timeout");
+
+        // A change asserts the line: one read for the scan that sees it, however many buttons read
+        reads = bus.readCount();
+        bus.setInput(9, LOW);
+        run(1);
+        check(bus.readCount() == reads + 1, "an asserted interrupt line reads the bus once in the next scan");
+        run(30);
+        check(bus.readCount() == reads + 1, "reading the bus clears the interrupt line");
+        check(buttons[9]->isPressed() && pressedCount(buttons) == 1, "a button sees its input of the expander");
+
+        // Two changes in one scan are one read
+        reads = bus.readCount();
+        bus.setInput(9, HIGH);
+        bus.setInput(2, LOW);
+        run(30);
+        check(bus.readCount() == reads + 1, "changes before a scan are read together");
+        check(buttons[2]->isPressed() && !buttons[9]->isPressed(), "both changes are seen");
+        for ( uint8_t i = 0; i < INPUTS; i++ ) delete buttons[i];
+    }
+
+    void polled() {
+        VirtualExpanderBus bus;
+        ExpanderInputBank8 expander(&bus, 5);
+        expander.begin();
+        EventButton a(expander.pin(0));
+        EventButton b(expander.pin(7));
+        a.begin();
+        b.begin();
+        run(10);
+        uint32_t reads = bus.readCount();
+        run(100);
+        check(bus.readCount() - reads == 20, "without an interrupt line the bus is read every read interval");
+        bus.setInput(7, LOW);
+        run(30);
+        check(b.isPressed() && !a.isPressed(), "a polled expander sees a change");
+        expander.setReadInterval(10);
+        reads = bus.readCount();
+        run(100);
+        check(bus.readCount() - reads == 10, "setReadInterval() changes the time between reads");
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    interruptGated();
+    polled();
+    return HostTest::result("ExpanderInputBank");
+}
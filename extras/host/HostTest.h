@@ -0,0 +1,44 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <Arduino.h>
+
+/**
+ * @brief The checks shared by the host tests. Each test is an executable that returns HostTest::result().
+ */
+namespace HostTest {
+
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    /**
+     * @brief Report a failed check (the test carries on so every failure is listed).
+     */
+    inline bool check(bool ok, const char* what) {
+        if ( !ok ) {
+            printf("FAILED: %s\n", what);
+            failures()++;
+        }
+        return ok;
+    }
+
+    /**
+     * @brief The exit code of the test: 0 if every check passed.
+     */
+    inline int result(const char* name) {
+        printf("%s: %s\n", name, failures() ? "FAILED" : "passed");
+        return failures() ? 1 : 0;
+    }
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks InterruptPinAdapter with edges pushed from a second thread (standing in for the ISR): edges are
+ * received intact and in order while the buffer is drained concurrently, an EventButton times presses from
+ * the edges however slow its loop, and after an overflow the input resyncs to the pin's last state.
+ */
+
+#include <atomic>
+#include <thread>
+#include <EventButton.h>
+#include "PinAdapter/InterruptPinAdapter.h"
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    const uint32_t CLOCK_MS = 4000000; // Well after any edge pushed by concurrentPushAndPop()
+
+    struct ButtonLog {
+        uint8_t pressed = 0;
+        uint8_t released = 0;
+        uint8_t clicked = 0;
+        uint8_t doubleClicked = 0;
+        uint32_t lastPressMs = 0;
+    } seen;
+
+    void onButton(InputEventType et, EventButton& b) {
+        switch ( et ) {
+            case InputEventType::PRESSED: seen.pressed++; break;
+            case InputEventType::RELEASED: seen.released++; seen.lastPressMs = b.previousDuration(); break;
+            case InputEventType::CLICKED: seen.clicked++; break;
+            case InputEventType::DOUBLE_CLICKED: seen.doubleClicked++; break;
+            default: break;
+        }
+    }
+
+    /**
+     * A producer thread pushes bursts of edges as fast as it can while this thread drains them. The state
+     * after each burst must be the pin's, however the threads interleave.
+     */
+    void concurrentPushAndPop() {
+        const uint8_t BURSTS = 10;
+        InterruptPinAdapter pin(2);
+        pin.begin();
+        uint32_t pushed = 0;
+        uint32_t popped = 0;
+        uint32_t resyncs = 0;
+        uint8_t stale = 0;
+        bool intact = true;
+        bool ordered = true;
+        for ( uint8_t burst = 0; burst < BURSTS; burst++ ) {
+            uint32_t first = pushed + 1;
+            uint32_t last = pushed + 5000 + (burst & 1); // Bursts end alternately LOW and HIGH
+            std::atomic<bool> done(false);
+            std::thread producer([&pin, &done, first, last]() {
+                for ( uint32_t i = first; i <= last; i++ ) {
+                    pin.pushEdge(i & 1, i, i * 1000UL + 7);
+                    if ( (i & 7) == 0 ) std::this_thread::yield(); // Interleave with the consumer
+                }
+                done = true;
+            });
+            uint32_t lastMs = 0;
+            bool lastState = !(last & 1);
+            PinEdge edge;
+            for ( bool finished = false; !finished; ) {
+                finished = done; // Drain once more after the producer has finished
+                while ( pin.popEdge(edge) ) {
+                    lastState = edge.state;
+                    if ( edge.ms > last ) { // Resync edges are timed now
+                        resyncs++;
+                        continue;
+                    }
+                    popped++;
+                    intact = intact && edge.us == edge.ms * 1000UL + 7 && edge.state == (edge.ms & 1);
+                    ordered = ordered && edge.ms > lastMs;
+                    lastMs = edge.ms;
+                }
+            }
+            producer.join();
+            pushed = last;
+            if ( lastState != (last & 1) ) stale++;
+        }
+        check(intact, "edges pushed from another thread arrive intact");
+        check(ordered, "edges arrive in the order they were pushed");
+        check(popped + pin.droppedCount() == pushed, "every edge is either received or counted as dropped");
+        check(!pin.droppedCount() || resyncs > 0, "dropped edges are followed by a resync edge");
+        check(stale == 0, "the last edge received after each burst has the pin's state");
+        PinEdge last;
+        check(pin.lastEdge(last) && last.state == (pushed & 1), "lastEdge() is the last edge popped");
+        printf("%u edges: %u received, %u dropped, %u resyncs\n", pushed, popped, pin.droppedCount(), resyncs);
+    }
+
+    /**
+     * Edges pushed from a thread between the updates of a slow loop are still timed from the edges.
+     */
+    void slowLoop() {
+        InterruptPinAdapter pin(2);
+        EventButton button(&pin);
+        button.setCallback(onButton);
+        button.begin();
+        std::thread isr([&pin]() {
+            pin.pushEdge(LOW, CLOCK_MS + 100); // A bouncy press
+            pin.pushEdge(HIGH, CLOCK_MS + 101);
+            pin.pushEdge(LOW, CLOCK_MS + 102);
+            pin.pushEdge(HIGH, CLOCK_MS + 160);
+        });
+        isr.join();
+        FakeArduino::advanceMillis(500);
+        button.update();
+        check(seen.pressed == 1 && seen.released == 1, "a press between updates fires PRESSED and RELEASED");
+        check(seen.lastPressMs >= 55 && seen.lastPressMs <= 60, "the press is timed from its edges");
+        FakeArduino::advanceMillis(500);
+        button.update();
+        check(seen.clicked == 1, "a press between updates fires CLICKED");
+
+        uint32_t at = CLOCK_MS + 1000;
+        std::thread clicks([&pin, at]() {
+            pin.pushEdge(LOW, at + 100);
+            pin.pushEdge(HIGH, at + 150);
+            pin.pushEdge(LOW, at + 250);
+            pin.pushEdge(HIGH, at + 300);
+        });
+        clicks.join();
+        FakeArduino::advanceMillis(1000);
+        button.update();
+        check(seen.doubleClicked == 1, "two clicks between updates fire DOUBLE_CLICKED");
+    }
+
+    /**
+     * More edges than the buffer holds: the button ends in the pin's last state.
+     */
+    void overflowAndResync() {
+        InterruptPinAdapter pin(2);
+        EventButton button(&pin);
+        button.setCallback(onButton);
+        button.begin();
+        uint32_t at = InputClock::ms();
+        std::thread isr([&pin, at]() {
+            for ( uint8_t i = 0; i < INPUT_EVENTS_EDGE_BUFFER_SIZE * 3; i++ ) {
+                pin.pushEdge(i & 1 ? HIGH : LOW, at + 1 + i * 30);
+            }
+            pin.pushEdge(LOW, at + 2000); // Ends pressed
+        });
+        isr.join();
+        check(pin.droppedCount() > 0, "a full buffer drops edges");
+        FakeArduino::advanceMillis(2100);
+        button.update();
+        FakeArduino::advanceMillis(50);
+        button.update();
+        check(button.isPressed(), "after dropped edges the button resyncs to the pin");
+        pin.pushEdge(HIGH, InputClock::ms());
+        FakeArduino::advanceMillis(50);
+        button.update();
+        check(!button.isPressed(), "edges after a resync are processed");
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    FakeArduino::advanceMillis(CLOCK_MS);
+    concurrentPushAndPop();
+    slowLoop();
+    overflowAndResync();
+    return HostTest::result("InterruptPinAdapter");
+}
@@ -0,0 +1,172 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks EventKeypad against a VirtualKeypadMatrix: one read of each row per scan, press, release and click
+ * events, keys debounced together, long presses, and ghost keys with and without enableGhostBlocking().
+ */
+
+#include <EventKeypad.h>
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    struct KeyEvent {
+        InputEventType et;
+        uint8_t key;
+        uint8_t clicks;
+    };
+
+    KeyEvent events[64];
+    uint8_t eventCount = 0;
+
+    void onKeypad(InputEventType et, EventKeypad& kp) {
+        if ( eventCount < 64 ) events[eventCount++] = { et, kp.key(), kp.clickCount() };
+    }
+
+    uint8_t count(InputEventType et, uint8_t key) {
+        uint8_t n = 0;
+        for ( uint8_t i = 0; i < eventCount; i++ ) {
+            if ( events[i].et == et && events[i].key == key ) n++;
+        }
+        return n;
+    }
+
+    uint8_t countKey(uint8_t key) {
+        uint8_t n = 0;
+        for ( uint8_t i = 0; i < eventCount; i++ ) {
+            if ( events[i].key == key ) n++;
+        }
+        return n;
+    }
+
+    VirtualKeypadMatrix matrix(4, 4);
+    EventKeypad keypad(&matrix);
+
+    // Update once a millisecond
+    void run(uint16_t ms) {
+        for ( uint16_t i = 0; i < ms; i++ ) {
+            FakeArduino::advanceMillis(1);
+            keypad.update();
+        }
+    }
+
+    void releaseAll() {
+        for ( uint8_t k = 0; k < 16; k++ ) matrix.setKey(k, false);
+        run(1000);
+        eventCount = 0;
+    }
+
+    void pressAndRelease() {
+        uint32_t reads = matrix.readCount();
+        run(10);
+        check(matrix.readCount() - reads == 10 * 4, "each update reads each row once");
+
+        matrix.press(1, 2);
+        run(9);
+        check(count(InputEventType::PRESSED, 6) == 0, "a press waits for the debounce interval");
+        run(2);
+        check(count(InputEventType::PRESSED, 6) == 1, "a press fires PRESSED for its key");
+        check(keypad.isPressed(1, 2) && keypad.isPressed(6) && keypad.pressedKeys() == (KeypadMask)1 << 6, "the key is pressed");
+
+        matrix.release(1, 2);
+        run(20);
+        check(count(InputEventType::RELEASED, 6) == 1, "a release fires RELEASED");
+        check(count(InputEventType::CLICKED, 6) == 0, "CLICKED waits for the multi click interval");
+        run(300);
+        check(count(InputEventType::CLICKED, 6) == 1, "a press and release fires CLICKED");
+        check(countKey(6) == 3, "a click fires no other events");
+        releaseAll();
+    }
+
+    void bounceAndMultipleKeys() {
+        // A press shorter than the debounce interval is ignored
+        matrix.press(0, 0);
+        run(3);
+        matrix.release(0, 0);
+        run(400);
+        check(eventCount == 0, "a bounce fires nothing");
+
+        // Two keys pressed together are debounced together
+        matrix.press(0, 0);
+        matrix.press(3, 3);
+        run(15);
+        check(count(InputEventType::PRESSED, 0) == 1 && count(InputEventType::PRESSED, 15) == 1, "two keys pressed together both fire");
+        releaseAll();
+
+        // Double click
+        for ( uint8_t i = 0; i < 2; i++ ) {
+            matrix.press(2, 1);
+            run(50);
+            matrix.release(2, 1);
+            run(50);
+        }
+        run(300);
+        check(count(InputEventType::DOUBLE_CLICKED, 9) == 1 && count(InputEventType::CLICKED, 9) == 0, "two clicks fire DOUBLE_CLICKED");
+        releaseAll();
+
+        // Long press
+        matrix.press(3, 0);
+        run(800);
+        check(count(InputEventType::LONG_PRESS, 12) == 1, "holding a key fires LONG_PRESS");
+        matrix.release(3, 0);
+        run(400);
+        check(count(InputEventType::LONG_CLICKED, 12) == 1 && count(InputEventType::CLICKED, 12) == 0, "releasing a long press fires LONG_CLICKED");
+        releaseAll();
+    }
+
+    void ghosting() {
+        matrix.enableGhosting();
+
+        // Three corners of a rectangle: (1, 1) reads as pressed too
+        matrix.press(0, 0);
+        matrix.press(0, 1);
+        matrix.press(1, 0);
+        run(20);
+        check(count(InputEventType::PRESSED, 5) == 1, "without blocking a ghost key fires");
+        releaseAll();
+
+        keypad.enableGhostBlocking();
+        matrix.press(0, 0);
+        run(20);
+        matrix.press(0, 1);
+        run(20);
+        check(count(InputEventType::PRESSED, 0) == 1 && count(InputEventType::PRESSED, 1) == 1, "keys in one row are not ghosts");
+        matrix.press(1, 0);
+        run(100);
+        check(countKey(5) == 0, "with blocking a ghost key does not fire");
+        check(!keypad.isPressed(1, 1), "with blocking a ghost key is not pressed");
+        check(countKey(4) == 0, "the rows of the rectangle keep their state while it lasts");
+
+        // Breaking the rectangle lets the rows change again
+        matrix.release(0, 1);
+        run(20);
+        check(count(InputEventType::RELEASED, 1) == 1, "a key released to break the rectangle fires RELEASED");
+        check(count(InputEventType::PRESSED, 4) == 1, "a held key fires PRESSED once the rectangle is broken");
+        check(countKey(5) == 0, "the ghost key never fires");
+
+        keypad.enableGhostBlocking(false);
+        matrix.enableGhosting(false);
+        releaseAll();
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    keypad.setCallback(onKeypad);
+    keypad.begin();
+    check(keypad.numKeys() == 16, "a 4x4 matrix has 16 keys");
+
+    pressAndRelease();
+    bounceAndMultipleKeys();
+    ghosting();
+
+    return HostTest::result("EventKeypad");
+}
@@ -0,0 +1,96 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks BasicPortSnapshot with eight EventButtons on one port: the port is read once per scan however many
+ * buttons read it, from either an input register or a read function, and each button sees its own bit.
+ */
+
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/PortSnapshot.h"
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    volatile uint8_t portRegister = 0xFF; // Pulled up
+
+    uint32_t functionReads = 0;
+    uint16_t functionLevels = 0xFFFF;
+    uint16_t readPort() {
+        functionReads++;
+        return functionLevels;
+    }
+
+    // Update once a millisecond
+    void run(uint16_t ms) {
+        for ( uint16_t i = 0; i < ms; i++ ) {
+            FakeArduino::advanceMillis(1);
+            InputRegistry::updateAll();
+        }
+    }
+
+    void registerSnapshot() {
+        PortSnapshot8 port(&portRegister);
+        EventButton* buttons[8];
+        for ( uint8_t i = 0; i < 8; i++ ) {
+            buttons[i] = new EventButton(port.pin(i));
+            buttons[i]->begin();
+        }
+        check(port.pin(8) == nullptr, "an 8 bit port has 8 pins");
+        run(10);
+
+        uint32_t refreshes = port.refreshCount();
+        run(100);
+        check(port.refreshCount() - refreshes == 100, "the port is read once per scan of eight buttons");
+
+        portRegister = 0xFF & ~(1 << 3);
+        run(30);
+        check(buttons[3]->isPressed(), "a button sees its bit of the port");
+        uint8_t pressed = 0;
+        for ( uint8_t i = 0; i < 8; i++ ) if ( buttons[i]->isPressed() ) pressed++;
+        check(pressed == 1, "the other buttons are not pressed");
+        portRegister = 0xFF;
+        run(30);
+        check(!buttons[3]->isPressed(), "a button is released with its bit");
+
+        // A button that is disabled does not read, the others still share one read per scan
+        buttons[0]->enable(false);
+        refreshes = port.refreshCount();
+        run(100);
+        check(port.refreshCount() - refreshes == 100, "the port is still read once per scan with a button disabled");
+        for ( uint8_t i = 0; i < 8; i++ ) delete buttons[i];
+    }
+
+    void functionSnapshot() {
+        BasicPortSnapshot<uint16_t> port(readPort);
+        EventButton low(port.pin(0));
+        EventButton high(port.pin(15));
+        low.begin();
+        high.begin();
+        run(10);
+        functionReads = 0;
+        run(50);
+        check(functionReads == 50, "the read function is called once per scan");
+        functionLevels = 0x7FFF;
+        run(30);
+        check(high.isPressed() && !low.isPressed(), "bit 15 of a 16 bit port is read");
+        check(port.value() == 0x7FFF, "value() is the last snapshot");
+        uint32_t refreshes = port.refreshCount();
+        check(port.refresh() == 0x7FFF && port.refreshCount() == refreshes + 1, "refresh() takes a snapshot now");
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    registerSnapshot();
+    functionSnapshot();
+    return HostTest::result("PortSnapshot");
+}
@@ -0,0 +1,8 @@
+// Runs examples/RegistryBenchmark once on the host: hand written update() calls against InputRegistry::updateAll()
+#include "../../examples/RegistryBenchmark/RegistryBenchmark.ino"
+
+int main() {
+    setup();
+    loop();
+    return buttonEvents > 0 ? 0 : 1; // Both approaches must have seen the buttons change
+}
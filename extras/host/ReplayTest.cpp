@@ -0,0 +1,148 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks InputReplay against a golden file: data/Session.csv (a button, a pot and an encoder) must replay to
+ * exactly the events in data/Session.golden, and changed, missing or extra events must be reported as
+ * mismatches.
+ *
+ * After a deliberate change to the events, check the new events and regenerate the golden file with
+ *
+ *     replay_test --write-golden > extras/host/data/Session.golden
+ */
+
+#include <string>
+#include <EventButton.h>
+#include <EventAnalog.h>
+#include <EventEncoder.h>
+#include <InputReplay.h>
+#include <VirtualEncoderAdapter.h>
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    /**
+     * A Stream over a string: reads from the text and appends what is written to it.
+     */
+    class TextStream : public Stream {
+        public:
+        explicit TextStream(const std::string& text = "") : text(text) {}
+        size_t write(uint8_t c) override { text += (char)c; return 1; }
+        int available() override { return (int)(text.size() - pos); }
+        int read() override { return pos < text.size() ? (uint8_t)text[pos++] : -1; }
+        int peek() override { return pos < text.size() ? (uint8_t)text[pos] : -1; }
+        std::string text;
+        private:
+        size_t pos = 0;
+    };
+
+    std::string readFile(const char* name) {
+        std::string path = std::string(HOST_DATA_DIR) + "/" + name;
+        std::string text;
+        FILE* f = fopen(path.c_str(), "rb");
+        if ( !f ) {
+            printf("Cannot open %s\n", path.c_str());
+            return text;
+        }
+        char buffer[256];
+        size_t n;
+        while ( (n = fread(buffer, 1, sizeof(buffer), f)) > 0 ) text.append(buffer, n);
+        fclose(f);
+        return text;
+    }
+
+    uint16_t countLines(const std::string& text) {
+        uint16_t lines = 0;
+        for ( char c : text ) if ( c == '\n' ) lines++;
+        return lines;
+    }
+
+    /**
+     * Replay the session into fresh inputs, logging the events and comparing them with a golden file (if not null).
+     */
+    ReplayResult replaySession(Print* log, Stream* golden) {
+        InputReplay replay; // Before the inputs so they start at simulated time 0
+        VirtualPinAdapter pin;
+        EventButton button(&pin);
+        VirtualAnalogAdapter pot;
+        EventAnalog analog(&pot);
+        VirtualEncoderAdapter knob;
+        EventEncoder encoder(&knob);
+        button.setInputId(1);
+        analog.setInputId(2);
+        encoder.setInputId(3);
+        replay.bindPin(0, &pin);
+        replay.bindAnalog(1, &pot);
+        replay.bindEncoder(2, &knob);
+        replay.setEventLog(log);
+        replay.setGolden(golden);
+        button.begin();
+        analog.begin();
+        encoder.begin();
+        TextStream recording(readFile("Session.csv"));
+        CsvReplaySource source(recording);
+        return replay.run(source);
+    }
+
+    /**
+     * The golden file with the type of one event changed.
+     */
+    std::string changeEventType(const std::string& golden, uint16_t index) {
+        std::string changed = golden;
+        size_t start = 0;
+        for ( uint16_t i = 0; i < index; i++ ) start = changed.find('\n', start) + 1;
+        size_t type = changed.find(',', changed.find(',', start) + 1) + 1; // ms,inputId,type,payload
+        changed[type] = changed[type] == '1' ? '2' : '1';
+        return changed;
+    }
+}
+
+int main(int argc, char** argv) {
+    if ( argc > 1 && std::string(argv[1]) == "--write-golden" ) {
+        TextStream log;
+        replaySession(&log, nullptr);
+        fputs(log.text.c_str(), stdout);
+        return 0;
+    }
+
+    std::string golden = readFile("Session.golden");
+    uint16_t goldenEvents = countLines(golden);
+    check(goldenEvents > 10, "the golden file has events");
+
+    // The session replays to exactly the golden events
+    TextStream log;
+    TextStream goldenIn(golden);
+    ReplayResult result = replaySession(&log, &goldenIn);
+    check(result.passed() && result.firstMismatch == -1, "the session matches its golden file");
+    check(result.events == goldenEvents, "every golden event is fired");
+    check(result.samples == 21 && result.ignored == 0, "every sample is applied");
+    check(log.text == golden, "the event log is the golden file");
+    check(result.simulatedMs >= 5000, "simulated time reaches the last sample");
+    printf("%u samples, %u events, %u updates, %ums simulated in %uus (%u samples/s)\n", result.samples, result.events,
+        result.updates, result.simulatedMs, result.elapsedUs, result.samplesPerSecond());
+
+    // A changed event is reported where it is
+    TextStream changed(changeEventType(golden, 3));
+    result = replaySession(nullptr, &changed);
+    check(!result.passed() && result.mismatches == 1 && result.firstMismatch == 3, "a changed event is a mismatch");
+
+    // An event missing from the golden file shifts the rest
+    std::string shortened = golden.substr(golden.find('\n') + 1);
+    TextStream missing(shortened);
+    result = replaySession(nullptr, &missing);
+    check(!result.passed() && result.firstMismatch == 0, "an event missing from the golden file is a mismatch");
+
+    // Events in the golden file that are not fired
+    TextStream extra(golden + "9000,1,3,0\n");
+    result = replaySession(nullptr, &extra);
+    check(!result.passed() && result.mismatches == 1 && result.firstMismatch == (int32_t)goldenEvents, "a golden event that is not fired is a mismatch");
+
+    return HostTest::result("InputReplay");
+}
@@ -0,0 +1,93 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/**
+ * Checks BasicShiftRegisterInputBank against a VirtualShiftRegisterChain of two 74HC165s with sixteen
+ * EventButtons: the chain is loaded and clocked through once per scan however many buttons read it, and the
+ * bits arrive in the right order for both MSBFIRST and LSBFIRST.
+ */
+
+#include <EventButton.h>
+#include <InputRegistry.h>
+#include "PinAdapter/ShiftRegisterInputBank.h"
+#include "HostTest.h"
+
+using HostTest::check;
+
+namespace {
+
+    // Update once a millisecond
+    void run(uint16_t ms) {
+        for ( uint16_t i = 0; i < ms; i++ ) {
+            FakeArduino::advanceMillis(1);
+            InputRegistry::updateAll();
+        }
+    }
+
+    void readsPerScan() {
+        const uint8_t INPUTS = 16;
+        VirtualShiftRegisterChain chain(INPUTS);
+        chain.setInputs(0xFFFF); // Pulled up
+        ShiftRegisterInputBank16 bank(&chain, INPUTS);
+        bank.begin();
+        EventButton* buttons[INPUTS];
+        for ( uint8_t i = 0; i < INPUTS; i++ ) {
+            buttons[i] = new EventButton(bank.pin(i));
+            buttons[i]->begin();
+        }
+        run(10);
+
+        uint32_t loads = chain.loadCount();
+        uint32_t clocks = chain.clockCount();
+        run(100);
+        check(chain.loadCount() - loads == 100, "the chain is loaded once per scan of sixteen buttons");
+        check(chain.clockCount() - clocks == 100 * INPUTS, "the chain is clocked through once per scan");
+
+        chain.setInput(12, LOW);
+        run(30);
+        uint8_t pressed = 0;
+        for ( uint8_t i = 0; i < INPUTS; i++ ) if ( buttons[i]->isPressed() ) pressed++;
+        check(buttons[12]->isPressed() && pressed == 1, "a button sees its input of the chain");
+        chain.setInput(12, HIGH);
+        run(30);
+        check(!buttons[12]->isPressed(), "a button is released with its input");
+        for ( uint8_t i = 0; i < INPUTS; i++ ) delete buttons[i];
+    }
+
+    void bitOrder() {
+        VirtualShiftRegisterChain chain(12);
+        chain.setInputs(0x0A53);
+        ShiftRegisterInputBank16 msb(&chain, 12);
+        msb.begin();
+        check(msb.value() == 0x0A53, "with MSBFIRST bit n is input n");
+
+        // The first bit clocked out (input 11) is bit 0
+        ShiftRegisterInputBank16 lsb(&chain, 12, LSBFIRST);
+        lsb.begin();
+        uint16_t reversed = 0;
+        for ( uint8_t i = 0; i < 12; i++ ) {
+            if ( (0x0A53 >> i) & 1 ) reversed |= 1 << (11 - i);
+        }
+        check(lsb.value() == reversed, "with LSBFIRST the bits are reversed");
+
+        // A bank shorter than the chain reads the inputs nearest its end
+        ShiftRegisterInputBank8 partial(&chain, 8);
+        partial.begin();
+        check(partial.value() == (0x0A53 >> 4), "a shorter bank reads the first bits clocked out");
+        check(partial.getLength() == 8, "getLength() is the bank's length");
+        ShiftRegisterInputBank8 clamped(&chain, 20);
+        check(clamped.getLength() == 8, "the length is at most the width of the mask");
+    }
+}
+
+int main() {
+    FakeArduino::setMicros(0);
+    readsPerScan();
+    bitOrder();
+    return HostTest::result("ShiftRegisterInputBank");
+}
@@ -0,0 +1,18 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+// Runs examples/UpdateBenchmark once on the host, with 1 to 10,000 instances of each input class
+
+#define MAX_INSTANCES 10000
+#include "../../examples/UpdateBenchmark/UpdateBenchmark.ino"
+
+int main() {
+    setup();
+    loop();
+    return eventCount > 0 ? 0 : 1; // The inputs must have seen the synthetic input
+}
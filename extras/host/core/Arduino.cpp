@@ -0,0 +1,88 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "Arduino.h"
+#include "Wire.h"
+#include <time.h>
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+namespace {
+    bool stopped = false;
+    uint64_t stoppedUs = 0;
+    uint64_t offsetUs = 0; // Added by delay() and advanceMicros() while the clock runs
+    uint8_t modes[FakeArduino::PINS];
+    int levels[FakeArduino::PINS];
+    int values[FakeArduino::PINS];
+
+    uint64_t hostUs() {
+        timespec t;
+        clock_gettime(CLOCK_MONOTONIC, &t);
+        return (uint64_t)t.tv_sec * 1000000ULL + t.tv_nsec / 1000;
+    }
+
+    uint64_t nowUs() {
+        return stopped ? stoppedUs : hostUs() + offsetUs;
+    }
+}
+
+void FakeArduino::useRealTime() {
+    if ( stopped ) offsetUs = stoppedUs - hostUs();
+    stopped = false;
+}
+
+void FakeArduino::setMicros(uint32_t us) {
+    stopped = true;
+    stoppedUs = us;
+}
+
+void FakeArduino::advanceMicros(uint32_t us) {
+    if ( stopped ) {
+        stoppedUs += us;
+    } else {
+        offsetUs += us;
+    }
+}
+
+void FakeArduino::setDigital(uint8_t pin, int level) {
+    if ( pin < PINS ) levels[pin] = level ? HIGH : LOW;
+}
+
+void FakeArduino::setAnalog(uint8_t pin, int value) {
+    if ( pin < PINS ) values[pin] = value;
+}
+
+void FakeArduino::reset() {
+    for ( uint8_t i = 0; i < PINS; i++ ) {
+        levels[i] = modes[i] == INPUT_PULLUP ? HIGH : LOW;
+        values[i] = 0;
+    }
+    useRealTime();
+}
+
+uint32_t millis() { return (uint32_t)(nowUs() / 1000); }
+
+uint32_t micros() { return (uint32_t)nowUs(); }
+
+// Time passes without the host waiting, so sketches with long delays run at full speed
+void delay(unsigned long ms) { FakeArduino::advanceMicros(ms * 1000UL); }
+
+void delayMicroseconds(unsigned int us) { FakeArduino::advanceMicros(us); }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if ( pin >= FakeArduino::PINS ) return;
+    if ( mode == INPUT_PULLUP && modes[pin] != INPUT_PULLUP ) levels[pin] = HIGH;
+    modes[pin] = mode;
+}
+
+int digitalRead(uint8_t pin) { return pin < FakeArduino::PINS ? levels[pin] : LOW; }
+
+void digitalWrite(uint8_t pin, uint8_t level) { FakeArduino::setDigital(pin, level); }
+
+int analogRead(uint8_t pin) { return pin < FakeArduino::PINS ? values[pin] : 0; }
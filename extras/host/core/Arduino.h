@@ -0,0 +1,168 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef FAKE_ARDUINO_H
+#define FAKE_ARDUINO_H
+
+/**
+ * A stand-in for the Arduino core, just enough to build the library and its sketches on a Linux host.
+ *
+ * Time follows the host's monotonic clock unless it is stopped with FakeArduino::setMicros(), after which
+ * it only moves with FakeArduino::advanceMicros() (or delay()). Pins read the levels and values set with
+ * FakeArduino::setDigital() and FakeArduino::setAnalog(). Serial prints to stdout.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define INPUT_PULLDOWN 0x3
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define DEFAULT 1
+
+#define F(s) (s)
+
+enum { A0 = 14, A1, A2, A3, A4, A5, A6, A7 };
+
+using std::min;
+using std::max;
+
+/**
+ * @brief The controls of the stand-in core.
+ */
+namespace FakeArduino {
+
+    /**
+     * @brief The number of digital and analog pins.
+     */
+    const uint8_t PINS = 64;
+
+    /**
+     * @brief Let millis() and micros() follow the host's clock (the default).
+     */
+    void useRealTime();
+
+    /**
+     * @brief Stop the clock at a time. It then only moves with advanceMicros(), advanceMillis() or delay().
+     */
+    void setMicros(uint32_t us);
+
+    /**
+     * @brief Move the clock on (whether or not it is stopped).
+     */
+    void advanceMicros(uint32_t us);
+
+    /**
+     * @brief Move the clock on by a number of milliseconds.
+     */
+    inline void advanceMillis(uint32_t ms) { advanceMicros(ms * 1000UL); }
+
+    /**
+     * @brief Set the level digitalRead() returns for a pin.
+     */
+    void setDigital(uint8_t pin, int level);
+
+    /**
+     * @brief Set the value analogRead() returns for a pin.
+     */
+    void setAnalog(uint8_t pin, int value);
+
+    /**
+     * @brief Set every pin LOW (or HIGH for INPUT_PULLUP), every analog value to 0 and let the clock run.
+     */
+    void reset();
+}
+
+uint32_t millis();
+uint32_t micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void yield() {}
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t level);
+int analogRead(uint8_t pin);
+
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void detachInterrupt(int) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+/**
+ * @brief Print as the Arduino core, to stdout.
+ */
+class Print {
+    public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+
+    size_t print(const char* s) { size_t n = 0; while ( *s ) n += write((uint8_t)*s++); return n; }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v) { return print((unsigned long)v); }
+    size_t print(int v) { return print((long)v); }
+    size_t print(unsigned int v) { return print((unsigned long)v); }
+    size_t print(long v) { char b[24]; snprintf(b, sizeof(b), "%ld", v); return print(b); }
+    size_t print(unsigned long v) { char b[24]; snprintf(b, sizeof(b), "%lu", v); return print(b); }
+    size_t print(long long v) { char b[24]; snprintf(b, sizeof(b), "%lld", v); return print(b); }
+    size_t print(unsigned long long v) { char b[24]; snprintf(b, sizeof(b), "%llu", v); return print(b); }
+    size_t print(double v) { char b[32]; snprintf(b, sizeof(b), "%.2f", v); return print(b); }
+
+    size_t println() { return print("\r\n"); }
+    template <class T>
+    size_t println(T v) { size_t n = print(v); return n + println(); }
+};
+
+/**
+ * @brief Stream as the Arduino core.
+ */
+class Stream : public Print {
+    public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+/**
+ * @brief Serial: writes to stdout, never has anything to read.
+ */
+class HardwareSerial : public Stream {
+    public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    explicit operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
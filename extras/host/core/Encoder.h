@@ -0,0 +1,42 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef FAKE_ENCODER_H
+#define FAKE_ENCODER_H
+
+#include "Arduino.h"
+
+namespace FakeArduino {
+
+    /// \cond DO_NOT_DOCUMENT
+    inline int32_t& encoderCount(uint8_t pin1) {
+        static int32_t counts[PINS];
+        return counts[pin1 < PINS ? pin1 : 0];
+    }
+    /// \endcond
+
+    /**
+     * @brief Turn the encoder on pin1 by a number of counts (negative to turn backwards).
+     */
+    inline void turnEncoder(uint8_t pin1, int32_t counts) { encoderCount(pin1) += counts; }
+}
+
+/**
+ * @brief A stand-in for PJRC's Encoder. Its count is moved with FakeArduino::turnEncoder().
+ */
+class Encoder {
+    public:
+    Encoder(uint8_t pin1, uint8_t /*pin2*/) : pin1(pin1) {}
+    int32_t read() { return FakeArduino::encoderCount(pin1); }
+    void write(int32_t count) { FakeArduino::encoderCount(pin1) = count; }
+
+    private:
+    uint8_t pin1;
+};
+
+#endif
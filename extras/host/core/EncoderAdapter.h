@@ -0,0 +1,25 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef FAKE_ENCODER_ADAPTER_H
+#define FAKE_ENCODER_ADAPTER_H
+
+#include "Arduino.h"
+
+/**
+ * @brief The interface of the EncoderAdapter library, which EventEncoder reads encoders through.
+ */
+class EncoderAdapter {
+    public:
+    virtual ~EncoderAdapter() {}
+    virtual void begin() = 0;
+    virtual int32_t getPosition() = 0;
+    virtual void setPosition(int32_t position) = 0;
+};
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef FAKE_PJRC_ENCODER_ADAPTER_H
+#define FAKE_PJRC_ENCODER_ADAPTER_H
+
+#include "EncoderAdapter.h"
+#include "Encoder.h"
+
+/**
+ * @brief The EncoderAdapter library's adapter for PJRC's Encoder, over the stand-in Encoder.
+ */
+class PjrcEncoderAdapter : public EncoderAdapter {
+    public:
+    PjrcEncoderAdapter(uint8_t pin1, uint8_t pin2) : encoder(pin1, pin2) {}
+    void begin() override {}
+    int32_t getPosition() override { return encoder.read(); }
+    void setPosition(int32_t position) override { encoder.write(position); }
+
+    private:
+    Encoder encoder;
+};
+
+#endif
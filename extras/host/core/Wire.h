@@ -0,0 +1,33 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef FAKE_WIRE_H
+#define FAKE_WIRE_H
+
+#include "Arduino.h"
+
+/**
+ * @brief A stand-in I2C bus with nothing on it: writes are dropped and every byte read is 0xFF (pulled up inputs).
+ */
+class TwoWire {
+    public:
+    void begin() {}
+    void beginTransmission(uint8_t) {}
+    size_t write(uint8_t) { return 1; }
+    uint8_t endTransmission(bool = true) { return 0; }
+    uint8_t requestFrom(uint8_t, uint8_t count) { pending = count; return count; }
+    int read() { return pending ? (pending--, 0xFF) : -1; }
+    int available() { return pending; }
+
+    private:
+    uint8_t pending = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "AdapterPool.h"
+
+#if INPUT_EVENTS_ADAPTER_POOL_SIZE > 0
+
+static_assert(INPUT_EVENTS_ADAPTER_POOL_SIZE <= 255, "INPUT_EVENTS_ADAPTER_POOL_SIZE must be no more than 255");
+
+namespace {
+    // Aligned storage for the adapters
+    union Slot {
+        void* alignPointer;
+        uint32_t alignWord;
+        unsigned char bytes[AdapterPool::SLOT_SIZE];
+    };
+    Slot slots[INPUT_EVENTS_ADAPTER_POOL_SIZE];
+    // The number of slots taken by the object starting at each slot, 0 if free (or taken by an earlier object)
+    uint8_t slotSpan[INPUT_EVENTS_ADAPTER_POOL_SIZE] = {0};
+    bool slotUsed[INPUT_EVENTS_ADAPTER_POOL_SIZE] = {false};
+}
+
+void* AdapterPool::allocate(uint8_t count) {
+    uint8_t run = 0;
+    for ( uint8_t i = 0; i < INPUT_EVENTS_ADAPTER_POOL_SIZE; i++ ) {
+        run = slotUsed[i] ? 0 : run + 1;
+        if ( run == count ) {
+            uint8_t first = i + 1 - count;
+            for ( uint8_t j = first; j <= i; j++ ) slotUsed[j] = true;
+            slotSpan[first] = count;
+            return slots[first].bytes;
+        }
+    }
+    return nullptr;
+}
+
+void AdapterPool::release(void* slot) {
+    uint8_t first = (Slot*)slot - slots;
+    for ( uint8_t j = first; j < first + slotSpan[first]; j++ ) slotUsed[j] = false;
+    slotSpan[first] = 0;
+}
+
+bool AdapterPool::contains(void* slot) {
+    return slot >= (void*)slots && slot < (void*)(slots + INPUT_EVENTS_ADAPTER_POOL_SIZE);
+}
+
+uint8_t AdapterPool::available() {
+    uint8_t n = 0;
+    for ( uint8_t i = 0; i < INPUT_EVENTS_ADAPTER_POOL_SIZE; i++ ) {
+        if ( !slotUsed[i] ) n++;
+    }
+    return n;
+}
+
+#else
+
+void* AdapterPool::allocate(uint8_t /*count*/) { return nullptr; }
+
+void AdapterPool::release(void* /*slot*/) { }
+
+bool AdapterPool::contains(void* /*slot*/) { return false; }
+
+uint8_t AdapterPool::available() { return 0; }
+
+#endif
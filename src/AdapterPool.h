@@ -0,0 +1,151 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef ADAPTER_POOL_H
+#define ADAPTER_POOL_H
+
+#include <Arduino.h>
+
+#if defined(__has_include)
+    #if __has_include(<new>)
+        #include <new>
+    #else
+        #include <new.h>
+    #endif
+#else
+    #include <new.h>
+#endif
+
+#include "PinAdapter/GpioPinAdapter.h"
+#include "PinAdapter/FoltmanDebounceAdapter.h"
+
+#ifndef INPUT_EVENTS_ADAPTER_POOL_SIZE
+/**
+ * @brief The number of adapters the AdapterPool can hold. Set with a build flag, eg 
+ * <code>-D INPUT_EVENTS_ADAPTER_POOL_SIZE=20</code>.
+ * @details Default is 0 (no pool) so adapters created by inputs are allocated with <code>new</code> as before.
+ * Each EventButton or EventSwitch constructed with a pin number uses two slots (pin and debouncer), each
+ * EventAnalog constructed with a pin one slot and each EventJoystick two. The handler table created by the 
+ * first on() call of an input uses several consecutive slots (see AdapterPool::slotsFor()), as do the key 
+ * states of an EventKeypad.
+ */
+#define INPUT_EVENTS_ADAPTER_POOL_SIZE 0
+#endif
+
+/**
+ * @brief Creates and destroys the adapters that inputs create for themselves (eg the GpioPinAdapter and 
+ * FoltmanDebounceAdapter created by <code>EventButton(byte pin)</code> or the GpioAnalogAdapter created by
+ * <code>EventAnalog(byte pin)</code>), the handler tables created by on() and the key states of an EventKeypad.
+ * 
+ * @details If INPUT_EVENTS_ADAPTER_POOL_SIZE is greater than 0, adapters are constructed in place in a 
+ * static pool so no heap memory is used, even when inputs are created and destroyed at runtime. 
+ * Objects bigger than a slot take several consecutive slots. Slots are returned to the pool when the 
+ * owning input is destroyed. If the pool is full the object is allocated with <code>new</code>.
+ * 
+ * Adapters you create and pass to an input are never owned or destroyed by the input.
+ */
+class AdapterPool {
+
+    public:
+
+    /**
+     * @brief The size of each pool slot - big enough for the adapters created by the library.
+     */
+    static constexpr size_t SLOT_SIZE = sizeof(GpioPinAdapter) > sizeof(FoltmanDebounceAdapter) 
+                                        ? sizeof(GpioPinAdapter) : sizeof(FoltmanDebounceAdapter);
+
+    /**
+     * @brief Construct an adapter in the pool (or on the heap if the pool is full).
+     * 
+     * @tparam T The adapter type
+     * @param args The adapter's constructor arguments
+     * @return T* The new adapter. Must be destroyed with destroy().
+     */
+    template <class T, class... Args>
+    static T* create(Args... args) {
+        void* slot = allocate(slotsFor(sizeof(T)));
+        if ( slot ) {
+            return new (slot) T(args...);
+        }
+        return new T(args...);
+    }
+
+    /**
+     * @brief Destroy an adapter created by create() and return its slots to the pool.
+     * 
+     * @param adapter The adapter (nullptr is ignored). If T is a base class, its destructor must be virtual.
+     */
+    template <class T>
+    static void destroy(T* adapter) {
+        if ( adapter == nullptr ) return;
+        if ( contains(adapter) ) {
+            adapter->~T();
+            release(adapter);
+        } else {
+            delete adapter;
+        }
+    }
+
+    /**
+     * @brief Construct an array of objects in the pool (or on the heap if the pool is full), eg the key states of an EventKeypad.
+     * 
+     * @tparam T The object type (default constructed)
+     * @param count The number of objects
+     * @return T* The first object. Must be destroyed with destroyArray().
+     */
+    template <class T>
+    static T* createArray(uint8_t count) {
+        size_t size = sizeof(T) * count;
+        void* slot = size <= SLOT_SIZE * 255 ? allocate(slotsFor(size)) : nullptr;
+        if ( !slot ) return new T[count];
+        T* items = (T*)slot;
+        for ( uint8_t i = 0; i < count; i++ ) new (&items[i]) T();
+        return items;
+    }
+
+    /**
+     * @brief Destroy an array created by createArray() and return its slots to the pool.
+     * 
+     * @param items The first object (nullptr is ignored)
+     * @param count The number of objects, as passed to createArray()
+     */
+    template <class T>
+    static void destroyArray(T* items, uint8_t count) {
+        if ( items == nullptr ) return;
+        if ( contains(items) ) {
+            for ( uint8_t i = 0; i < count; i++ ) items[i].~T();
+            release(items);
+        } else {
+            delete[] items;
+        }
+    }
+
+    /**
+     * @brief The number of slots taken by an object of a size, eg <code>slotsFor(sizeof(T))</code>.
+     */
+    static constexpr uint8_t slotsFor(size_t size) { return (size + SLOT_SIZE - 1) / SLOT_SIZE; }
+
+    /**
+     * @brief The number of free slots in the pool.
+     */
+    static uint8_t available();
+
+    /**
+     * @brief The total number of slots in the pool (INPUT_EVENTS_ADAPTER_POOL_SIZE).
+     */
+    static uint8_t capacity() { return INPUT_EVENTS_ADAPTER_POOL_SIZE; }
+
+    private:
+
+    static void* allocate(uint8_t count);
+    static void release(void* slot);
+    static bool contains(void* slot);
+
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef AnalogAdapter_h
+#define AnalogAdapter_h
+
+#include <stdint.h>
+
+/**
+ * @brief The interface specification for analog and joystick axis inputs.
+ * 
+ * @details Implement this to read an EventAnalog or EventJoystick from an external ADC, a multiplexer or
+ * samples taken elsewhere (eg several channels read in one transfer, then given out to an adapter per channel).
+ */
+class AnalogAdapter {
+    public:
+    /**
+     * @brief Initialise the analog adapter. Must be safe for repeated calls (Idempotent)
+     * 
+     */
+    virtual void begin() = 0;
+    /**
+     * @brief Read the current value, in the range of the input's adcBits
+     * 
+     * @return uint16_t The value
+     */
+    virtual uint16_t read() = 0;
+
+    virtual ~AnalogAdapter() = default;
+};
+
+#endif
@@ -0,0 +1,342 @@
+#ifndef AsyncAnalogSampler_h
+#define AsyncAnalogSampler_h
+
+#include <Arduino.h>
+#include "AnalogAdapter.h"
+#include "../InputClock.h"
+
+#ifndef INPUT_EVENTS_ASYNC_ANALOG_CHANNELS
+/**
+ * @brief The number of channels an AsyncAnalogSampler can sample. Can be overridden with a build flag.
+ */
+#define INPUT_EVENTS_ASYNC_ANALOG_CHANNELS 8
+#endif
+
+/**
+ * @brief An ADC that converts in the background: start() a conversion, then collect the result() once ready().
+ *
+ * @details Implemented by AvrAsyncAdc, AnalogReadAdc and SimulatedAsyncAdc.
+ */
+class AsyncAdc {
+
+    public:
+
+    virtual ~AsyncAdc() {}
+
+    /**
+     * @brief Start a conversion of a pin and return immediately.
+     */
+    virtual void start(uint8_t pin) = 0;
+
+    /**
+     * @brief Returns true when the conversion is complete.
+     */
+    virtual bool ready() = 0;
+
+    /**
+     * @brief The result of the completed conversion.
+     */
+    virtual uint16_t result() = 0;
+
+    /**
+     * @brief Read a pin, waiting for the conversion (eg to set the start value in <code>begin()</code>).
+     */
+    virtual uint16_t read(uint8_t pin) = 0;
+};
+
+/**
+ * @brief An AsyncAdc that converts with <code>analogRead()</code> in start(), so it is always ready.
+ *
+ * @details This does not save any time but lets a sketch written for an AsyncAnalogSampler run on boards
+ * without an AsyncAdc implementation.
+ */
+class AnalogReadAdc : public AsyncAdc {
+
+    public:
+
+    void start(uint8_t pin) override { value = analogRead(pin); }
+
+    bool ready() override { return true; }
+
+    uint16_t result() override { return value; }
+
+    uint16_t read(uint8_t pin) override { return analogRead(pin); }
+
+    private:
+    uint16_t value = 0;
+};
+
+#if defined(__AVR__) && defined(ADCSRA) && defined(ADSC)
+/**
+ * @brief An AsyncAdc for the AVR (eg UNO, Mega) ADC. A conversion takes about 100us, which
+ * <code>analogRead()</code> spends waiting.
+ *
+ * @details The pins are mapped to channels as <code>analogRead()</code>. The ADC reference is set on each
+ * conversion, so pass the reference you would pass to <code>analogReference()</code>.
+ */
+class AvrAsyncAdc : public AsyncAdc {
+
+    public:
+
+    /**
+     * @brief Construct the ADC.
+     *
+     * @param reference DEFAULT (the default), INTERNAL etc
+     */
+    AvrAsyncAdc(uint8_t reference = DEFAULT)
+    : reference(reference) {}
+
+    void start(uint8_t pin) override {
+        uint8_t channel = toChannel(pin);
+        #if defined(ADCSRB) && defined(MUX5)
+        ADCSRB = (ADCSRB & ~(1 << MUX5)) | (((channel >> 3) & 0x01) << MUX5);
+        #endif
+        ADMUX = (reference << 6) | (channel & 0x07);
+        ADCSRA |= (1 << ADSC);
+    }
+
+    bool ready() override { return !(ADCSRA & (1 << ADSC)); }
+
+    uint16_t result() override {
+        uint8_t low = ADCL; // ADCL must be read first
+        uint8_t high = ADCH;
+        return (high << 8) | low;
+    }
+
+    uint16_t read(uint8_t pin) override {
+        while ( !ready() ) {} // Let a conversion in progress finish
+        return analogRead(pin);
+    }
+
+    private:
+
+    static uint8_t toChannel(uint8_t pin) {
+        #if defined(analogPinToChannel)
+            #if defined(__AVR_ATmega32U4__)
+            if ( pin >= 18 ) pin -= 18;
+            #endif
+            return analogPinToChannel(pin);
+        #elif defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+            return pin >= 54 ? pin - 54 : pin;
+        #elif defined(__AVR_ATmega1284__) || defined(__AVR_ATmega1284P__) || defined(__AVR_ATmega644__) || defined(__AVR_ATmega644A__) || defined(__AVR_ATmega644P__) || defined(__AVR_ATmega644PA__)
+            return pin >= 24 ? pin - 24 : pin;
+        #else
+            return pin >= 14 ? pin - 14 : pin;
+        #endif
+    }
+
+    uint8_t reference;
+};
+#endif
+
+/**
+ * @brief A simulated AsyncAdc with a configurable conversion time, eg for tests.
+ *
+ * @details The value is held when the conversion starts and is ready once the conversion time has passed
+ * (by InputClock, so it can be driven by an InputReplay or a fake clock).
+ */
+class SimulatedAsyncAdc : public AsyncAdc {
+
+    public:
+
+    /**
+     * @brief Construct the ADC.
+     *
+     * @param conversionUs The conversion time, default 104us (an AVR at 16MHz)
+     */
+    SimulatedAsyncAdc(uint16_t conversionUs = 104)
+    : conversionUs(conversionUs) {}
+
+    void start(uint8_t pin) override {
+        held = read(pin);
+        startUs = InputClock::us();
+        converting = true;
+        starts++;
+    }
+
+    bool ready() override {
+        return !converting || (uint32_t)(InputClock::us() - startUs) >= conversionUs;
+    }
+
+    uint16_t result() override {
+        converting = false;
+        return held;
+    }
+
+    uint16_t read(uint8_t pin) override {
+        for ( uint8_t i = 0; i < pinCount; i++ ) {
+            if ( pins[i] == pin ) return values[i];
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Set the value of a pin (pins that have not been set read 0).
+     *
+     * @return false if INPUT_EVENTS_ASYNC_ANALOG_CHANNELS pins have already been set
+     */
+    bool setValue(uint8_t pin, uint16_t value) {
+        for ( uint8_t i = 0; i < pinCount; i++ ) {
+            if ( pins[i] == pin ) {
+                values[i] = value;
+                return true;
+            }
+        }
+        if ( pinCount == INPUT_EVENTS_ASYNC_ANALOG_CHANNELS ) return false;
+        pins[pinCount] = pin;
+        values[pinCount++] = value;
+        return true;
+    }
+
+    /**
+     * @brief Set the conversion time.
+     */
+    void setConversionTime(uint16_t us) { conversionUs = us; }
+
+    /**
+     * @brief The number of conversions started.
+     */
+    uint32_t startCount() { return starts; }
+
+    private:
+    uint16_t conversionUs;
+    uint32_t startUs = 0;
+    bool converting = false;
+    uint16_t held = 0;
+    uint32_t starts = 0;
+    uint8_t pins[INPUT_EVENTS_ASYNC_ANALOG_CHANNELS];
+    uint16_t values[INPUT_EVENTS_ASYNC_ANALOG_CHANNELS];
+    uint8_t pinCount = 0;
+};
+
+class AsyncAnalogSampler;
+
+/**
+ * @brief An AnalogAdapter for one channel of an AsyncAnalogSampler. Get one with AsyncAnalogSampler::channel().
+ *
+ */
+class AsyncAnalogAdapter final : public AnalogAdapter {
+
+    public:
+    /**
+     * @brief Sets the first value with a blocking read, so an EventAnalog starts at the right position.
+     */
+    void begin();
+
+    /**
+     * @brief Moves the sampler on and returns the latest completed sample of the pin. Never waits for the ADC.
+     */
+    uint16_t read();
+
+    private:
+    friend class AsyncAnalogSampler;
+    AsyncAnalogSampler* sampler = nullptr;
+    uint8_t pin = 0;
+    uint16_t value = 0;
+};
+
+/**
+ * @brief Samples several analog pins through an AsyncAdc in round-robin order without waiting for conversions.
+ *
+ * @details <code>analogRead()</code> waits for each conversion (about 100us on an AVR), so a joystick and four
+ * potentiometers spend around 600us of every loop waiting. With an AsyncAnalogSampler, each time one of its
+ * channels is read (or update() is called) a completed conversion is stored for its pin and the next pin's
+ * conversion is started - so reads return at once with the latest sample, and the pins take turns at the ADC.
+ * Pass the AnalogAdapter from channel() to an EventAnalog or EventJoystick:
+ *
+ * ```cpp
+ * AvrAsyncAdc adc;
+ * AsyncAnalogSampler sampler(&adc);
+ * EventAnalog pot(sampler.channel(A0));
+ * EventJoystick joystick(sampler.channel(A1), sampler.channel(A2));
+ * ```
+ *
+ * Each pin is sampled once every channelCount() conversions, so the samples are a few loops old.
+ */
+class AsyncAnalogSampler {
+
+    public:
+
+    /**
+     * @brief Construct a sampler.
+     *
+     * @param adc The ADC
+     */
+    AsyncAnalogSampler(AsyncAdc* adc)
+    : adc(adc) {}
+
+    /// \cond DO_NOT_DOCUMENT
+    AsyncAnalogSampler(const AsyncAnalogSampler&) = delete; // The channels point to the sampler
+    AsyncAnalogSampler& operator=(const AsyncAnalogSampler&) = delete;
+    /// \endcond
+
+    /**
+     * @brief The AnalogAdapter for a pin, adding it to the round-robin if it is new.
+     *
+     * @param pin *Must* be an analog pin
+     * @return AnalogAdapter* nullptr if INPUT_EVENTS_ASYNC_ANALOG_CHANNELS pins have already been added
+     */
+    AnalogAdapter* channel(uint8_t pin) {
+        for ( uint8_t i = 0; i < count; i++ ) {
+            if ( channels[i].pin == pin ) return &channels[i];
+        }
+        if ( count == INPUT_EVENTS_ASYNC_ANALOG_CHANNELS ) return nullptr;
+        AsyncAnalogAdapter& c = channels[count++];
+        c.sampler = this;
+        c.pin = pin;
+        return &c;
+    }
+
+    /**
+     * @brief Store the result of a completed conversion and start the next. Returns at once if the ADC is busy.
+     */
+    void update() {
+        if ( count == 0 ) return;
+        if ( converting ) {
+            if ( !adc->ready() ) return;
+            channels[current].value = adc->result();
+            conversions++;
+            if ( ++current >= count ) current = 0;
+        }
+        adc->start(channels[current].pin);
+        converting = true;
+    }
+
+    /**
+     * @brief The number of pins being sampled.
+     */
+    uint8_t channelCount() { return count; }
+
+    /**
+     * @brief The number of completed conversions.
+     */
+    uint32_t conversionCount() { return conversions; }
+
+    private:
+    friend class AsyncAnalogAdapter;
+
+    void beginChannel(AsyncAnalogAdapter& c) {
+        converting = false; // read() takes the ADC, the interrupted pin is started again by update()
+        c.value = adc->read(c.pin);
+    }
+
+    AsyncAdc* adc;
+    AsyncAnalogAdapter channels[INPUT_EVENTS_ASYNC_ANALOG_CHANNELS];
+    uint8_t count = 0;
+    uint8_t current = 0;
+    bool converting = false;
+    uint32_t conversions = 0;
+};
+
+inline void AsyncAnalogAdapter::begin() {
+    pinMode(pin, INPUT);
+    delayMicroseconds(2000); // Allow pin to settle
+    sampler->beginChannel(*this);
+}
+
+inline uint16_t AsyncAnalogAdapter::read() {
+    sampler->update();
+    return value;
+}
+
+#endif
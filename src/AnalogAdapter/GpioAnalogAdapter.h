@@ -0,0 +1,36 @@
+#ifndef GpioAnalogAdapter_h
+#define GpioAnalogAdapter_h
+
+#include <Arduino.h>
+#include "AnalogAdapter.h"
+
+/**
+ * @brief This is the default AnalogAdapter for the board's analog pins, read with <code>analogRead()</code>.
+ * 
+ */
+class GpioAnalogAdapter : public AnalogAdapter {
+
+    public:
+    /**
+     * @brief Construct a new Gpio Analog Adapter
+     * 
+     * @param pin *Must* be an analog pin. For ESP32 avoid using pins attached to ADC2 (GPIO 0, 2, 4, 12-15, 25-27) as these are shared by the WiFi module.
+     */
+    GpioAnalogAdapter(byte pin)
+    : analogPin(pin)
+    { }
+
+    void begin() {
+        pinMode(analogPin, INPUT);
+        delayMicroseconds(2000); // Allow pin to settle
+    }
+
+    uint16_t read() {
+        return analogRead(analogPin);
+    }
+
+    private:
+    byte analogPin;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef VirtualAnalogAdapter_h
+#define VirtualAnalogAdapter_h
+
+#include <Arduino.h>
+#include "AnalogAdapter.h"
+
+/**
+ * @brief An AnalogAdapter whose value can be set programmatically (eg for tests or with an InputReplay).
+ * 
+ */
+class VirtualAnalogAdapter : public AnalogAdapter {
+
+    public:
+    /**
+     * @brief Construct a VirtualAnalogAdapter.
+     * 
+     * @param value The initial value, eg the centre of the ADC range for a joystick axis.
+     */
+    VirtualAnalogAdapter(uint16_t value = 0)
+    : value(value)
+    { }
+
+    /**
+     * @brief Does nothing - the value is kept.
+     */
+    void begin() { }
+
+    /**
+     * @brief Returns the current value
+     */
+    uint16_t read() {
+        return value;
+    }
+
+    /**
+     * @brief Set the value.
+     * 
+     * @param newValue 
+     */
+    void setValue(uint16_t newValue) {
+        value = newValue;
+    }
+
+    private:
+    uint16_t value;
+};
+
+#endif
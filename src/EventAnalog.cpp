@@ -9,22 +9,39 @@
 
 #include "EventAnalog.h"
 
-EventAnalog::EventAnalog(byte pin, uint8_t adcBits /*=10*/) {
-    analogPin = pin;
+static_assert(sizeof(EventAnalog) <= INPUT_EVENTS_SIZE_LIMIT((56, 76, 112, 68, 96), (79, 100, 136, 92, 120)), "EventAnalog has grown (see INPUT_EVENTS_SIZE_LIMIT)");
+
+EventAnalog::EventAnalog(byte pin, uint8_t adcBits /*=10*/)
+    : EventAnalog(AdapterPool::create<GpioAnalogAdapter>(pin), adcBits, true) {}
+
+EventAnalog::EventAnalog(AnalogAdapter* adapter, uint8_t adcBits /*=10*/)
+    : EventAnalog(adapter, adcBits, false) {}
+
+EventAnalog::EventAnalog(AnalogAdapter* adapter, uint8_t adcBits, bool ownsAdapter)
+    : _reversePosition(false),
+      autoCalibrate(true),
+      _hasChanged(false),
+      _started(false),
+      ownsAnalogAdapter(ownsAdapter),
+      analogAdapter(adapter) {
     adcMax = (1U << adcBits) - 1;
     minVal = adcMax/20;
     maxVal = adcMax - minVal;
 }
 
+EventAnalog::~EventAnalog() {
+    if ( ownsAnalogAdapter ) AdapterPool::destroy(analogAdapter);
+}
+
 void EventAnalog::begin() {
-    pinMode(analogPin, INPUT);
-    delayMicroseconds(2000); // Allow pin to settle
+    analogAdapter->begin();
     setSliceNeg();
     setSlicePos();
     // Some boards change the ADC value between begin() and first update())
     // so this is re-called in update(). Required here so position() can be used
     // before first update();
     setInitialReadPos();
+    registerInput();
 }
 
 void EventAnalog::unsetCallback() {
@@ -32,13 +49,8 @@ void EventAnalog::unsetCallback() {
     EventInputBase::unsetCallback();
 }
 
-void EventAnalog::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
-}
-
-void EventAnalog::update() {
+void EventAnalog::update(uint32_t nowMs) {
+    updateMs = nowMs;
     if (!_started) {
         // This should only be required in begin() method but on some boards (ESP32s mainly) 
         // the analog output will change between begin() and the first update()
@@ -50,7 +62,7 @@ void EventAnalog::update() {
 
     if ( _enabled || autoCalibrate ) {
         _hasChanged = false;
-        readVal = analogRead(analogPin);
+        readVal = analogAdapter->read();
         // For joysticks, resistance either side of centre can be quite 
         // different ranges so we need to slice both sides
         if ( autoCalibrate ) {
@@ -61,21 +73,30 @@ void EventAnalog::update() {
             }
         }
         if ( _enabled ) {
-            if( millis() > (rateLimitCounter + rateLimit) ) { 
-                setReadPos(readVal - startVal);
-                if ( currentPos != readPos ) {
-                    previousPos = currentPos;
-                    currentPos = readPos;
-                    _hasChanged = true;
-                    invoke(InputEventType::CHANGED);
-                }
-                rateLimitCounter = millis();
+            setReadPos(readVal - startVal);
+            // A change within the rate limit window is held back (see nextDeadlineMs())
+            if ( currentPos != readPos && (InputTicks)(nowMs - rateLimitCounter) > rateLimit ) {
+                previousPos = currentPos;
+                currentPos = readPos;
+                _hasChanged = true;
+                eventUs = InputClock::us(); // Only read for a change, within a conversion (~100us) of the sample
+                invoke(InputEventType::CHANGED);
+                rateLimitCounter = nowMs;
             }
-            EventInputBase::update();
+            EventInputBase::update(nowMs);
         }
     }
 }
 
+uint32_t EventAnalog::nextDeadlineMs(uint32_t nowMs) {
+    uint32_t next = EventInputBase::nextDeadlineMs(nowMs);
+    if ( _enabled && currentPos != readPos ) {
+        uint32_t elapsed = (InputTicks)(nowMs - rateLimitCounter);
+        next = min(next, elapsed > rateLimit ? 0 : rateLimit + 1 - elapsed);
+    }
+    return next;
+}
+
 void EventAnalog::setReadPos(int16_t offset) {
     if ( offset > startBoundary) { //Going up!
         if ( abs(readVal - previousVal) > slicePos ) {
@@ -97,7 +118,7 @@ void EventAnalog::setReadPos(int16_t offset) {
 
 void EventAnalog::setInitialReadPos() {
     // Set the start position so we don't trigger an event before moving
-    readVal = analogRead(analogPin);
+    readVal = analogAdapter->read();
     setReadPos(readVal - startVal);
     currentPos = readPos;
     previousPos = currentPos;
@@ -121,7 +142,7 @@ void EventAnalog::setMaxValue(uint16_t val) {
 }
 
 void EventAnalog::setStartValue() {
-    setStartValue(analogRead(analogPin));
+    setStartValue(analogAdapter->read());
 }
 
 
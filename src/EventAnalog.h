@@ -12,6 +12,8 @@
 
 #include "Arduino.h"
 #include "EventInputBase.h"
+#include "AdapterPool.h"
+#include "AnalogAdapter/GpioAnalogAdapter.h"
 
 /**
  * @brief The EventAnalog class is for analog inputs - slice an analog range into configurable number of increments.
@@ -29,13 +31,26 @@ The following InputEventTypes are fired by EventAnalog:
  */
 class EventAnalog : public EventInputBase {
 
+private:
+
+    // Declared before the callback so the flags and rate limit fill the padding at the end of EventInputBase
+    bool _reversePosition INPUT_EVENTS_FLAG;
+
+    bool autoCalibrate INPUT_EVENTS_FLAG;
+    bool _hasChanged INPUT_EVENTS_FLAG;
+    bool _started INPUT_EVENTS_FLAG;
+    bool ownsAnalogAdapter INPUT_EVENTS_FLAG; //analogAdapter was created by the constructor
+
+    uint16_t rateLimit = 0;
+    InputTicks rateLimitCounter = 0;
+
 protected:
 
     #if defined(FUNCTIONAL_SUPPORTED)
         /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
+         * @brief If <code>std::function</code> is supported, this creates the callback type (a heap free InputDelegate by default).
          */
-        typedef std::function<void(InputEventType et, EventAnalog &ie)> CallbackFunction;
+        typedef InputCallback<void(InputEventType et, EventAnalog &ie)> CallbackFunction;
     #else
         /**
          * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
@@ -48,12 +63,18 @@ protected:
      */
     CallbackFunction callbackFunction = nullptr;
 
+
     /**
      * @brief Override of the <code>EventInputBase::invoke()</code> virtual method.
      * 
      * @param et Enum of type <code>InputEventType</code>
      */
-    void invoke(InputEventType et) override;
+    void invoke(InputEventType et) override { invokeHandler(et, callbackFunction, *this); }
+
+    /**
+     * @brief Override of the <code>EventInputBase::eventPayload()</code> virtual method. Returns position().
+     */
+    int16_t eventPayload(InputEventType /*et*/) override { return position(); }
 
 public:
 
@@ -68,6 +89,24 @@ public:
      * @param adcBits For most boards the default 10 (bits) will work fine but if your board has an ADC (analog to digital converter) resolution that is higher, pass the resolution (in bits) of your board. For most ESP32s this is 12.
      */
     EventAnalog(byte analogPin, uint8_t adcBits=10);
+
+    /**
+     * @brief Construct an EventAnalog input that reads an AnalogAdapter (eg an external ADC or a VirtualAnalogAdapter)
+
+     * @param analogAdapter The adapter. It is not destroyed with the EventAnalog.
+     * @param adcBits The resolution (in bits) of the values returned by the adapter. Default is 10.
+     */
+    EventAnalog(AnalogAdapter* analogAdapter, uint8_t adcBits=10);
+
+    /**
+     * @brief Destroy the EventAnalog, its per-event handler table and any adapter it created.
+     */
+    ~EventAnalog();
+
+    /// \cond DO_NOT_DOCUMENT
+    EventAnalog(const EventAnalog&) = delete; // Owns the handler table
+    EventAnalog& operator=(const EventAnalog&) = delete;
+    /// \endcond
     ///@}
 
 
@@ -120,10 +159,33 @@ public:
      */
     void unsetCallback() override;
 
+    /**
+     * @brief Set a handler for a single event type. It is called instead of the callback for that event.
+     * 
+     * @details Events without a handler are passed to the callback (if set), so there is no need for a 
+     * <code>switch</code> in the callback. If no callback is set, events without a handler are ignored.
+     * Up to INPUT_EVENTS_HANDLERS handlers can be set - the handler table is created the first time on() is called 
+     * (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     * 
+     * @param et The event, eg <code>InputEventType::CLICKED</code>
+     * @param handler A function of type <code>EventAnalog::CallbackFunction</code> or nullptr to remove the handler
+     * @return false if the handler table is full
+     */
+    bool on(InputEventType et, CallbackFunction handler) { return setHandler(et, handler); }
+
     /**
      * @brief Update the state from the analog input. Must be called from within <code>loop()</code> in order to update state from the pin.
      */
-    void update();
+    void update(uint32_t nowMs) override;
+    using EventInputBase::update;
+
+    /**
+     * @brief The number of milliseconds until a change held back by the rate limit or the IDLE event is due.
+     * 
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs(uint32_t nowMs) override;
+    using EventInputBase::nextDeadlineMs;
     /*@}*/
 
     ///@{
@@ -306,7 +368,8 @@ public:
     void setSlicePos() { slicePos = max(((maxVal-endBoundary-startBoundary-startVal)/positiveIncrements),1);  }//Never allow 0
 
 private:
-    byte analogPin = 0;
+    EventAnalog(AnalogAdapter* analogAdapter, uint8_t adcBits, bool ownsAdapter);
+    AnalogAdapter* analogAdapter;
     int16_t startVal = 0;
     int16_t readVal = startVal;
     int16_t currentVal = startVal;
@@ -326,14 +389,6 @@ private:
     int16_t readPos = 0;
     int16_t currentPos = 0;
     int16_t previousPos = 0;
-    bool _reversePosition = false;
-
-    bool autoCalibrate = true;
-    bool _hasChanged = false;
-    bool _started = false;
-
-    uint16_t rateLimit = 0;
-    unsigned long rateLimitCounter = 0;   
 
     void setReadPos(int16_t offset);
     void setInitialReadPos();
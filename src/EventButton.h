@@ -10,9 +10,27 @@
 
 #include "Arduino.h"
 #include "EventInputBase.h"
+#include "AdapterPool.h"
 #include "PinAdapter/FoltmanDebounceAdapter.h"
 #include "PinAdapter/GpioPinAdapter.h"
 
+/**
+ * @brief The click and long press timings of an EventButton.
+ * @details Each button holds its own ButtonTimings. When INPUT_EVENTS_COMPACT is defined buttons instead point to 
+ * ButtonTimings::shared (or a ButtonTimings set with setTimings()), saving 8 bytes per button.
+ */
+struct ButtonTimings {
+    uint16_t multiClickInterval = 250;
+    uint16_t longClickDuration = 750;
+    uint16_t longPressInterval = 500;
+    bool repeatLongPress = true;
+
+    /**
+     * @brief The timings used by all buttons in compact mode, unless setTimings() is called.
+     */
+    static ButtonTimings shared;
+};
+
 /**
  * @brief The EventButton class is for momentary inputs. The momentary switch (button) must be wired between the pin and GND.
 
@@ -31,21 +49,62 @@ The following InputEventTypes are fired by EventButton:
   - InputEventType::LONG_PRESS - fired *during* a long press (hence change of tense). Will repeat by default but this can be turned off.
   - InputEventType::LONG_CLICKED - fired *after* a long press.
  * 
+ * EventButton derives from BasicEventButton<PinAdapter, DebounceAdapter> and works with any adapters via virtual calls. 
+ * If the adapter types are known at compile time, pass them as the template arguments (eg GpioEventButton) 
+ * so reading and debouncing the pin can be inlined into update().
+ * 
+ * @tparam PinT The PinAdapter type
+ * @tparam DebounceT The DebounceAdapter type. Concrete types must implement debounce(pinState, ms).
+ * @tparam SelfT The class passed to callbacks, for classes derived from this one (eg EventButton). Defaults to BasicEventButton.
  */
-class EventButton : public EventInputBase {
+template <class PinT, class DebounceT, class SelfT = void>
+class BasicEventButton : public EventInputBase {
+
+    private:
+
+    // Declared before the callback and adapters so the flags, times and counters fill the padding at the end of EventInputBase
+    bool ownsPinAdapter INPUT_EVENTS_FLAG; //pinAdapter was created by the constructor
+    bool ownsDebouncer INPUT_EVENTS_FLAG; //debouncer was created by the constructor
+    bool pressedState INPUT_EVENTS_FLAG; //The state that represents 'pressed'
+
+    //state
+
+    bool currentPinState INPUT_EVENTS_FLAG;
+    bool previousPinState INPUT_EVENTS_FLAG;
+
+    bool currentState INPUT_EVENTS_FLAG; //set via PinAdapter->read()
+    bool previousState INPUT_EVENTS_FLAG;
+    bool stateChanged INPUT_EVENTS_FLAG;
+    bool edgeCapture INPUT_EVENTS_FLAG; //PinAdapter captures edges
+    bool edgeState INPUT_EVENTS_FLAG; //State of the last captured edge
+    bool clickFired INPUT_EVENTS_FLAG;
+    InputTicks stateChangeLastTime = 0;
+    InputTicks durationOfPreviousState = 0;
+    InputTicks deadlineAtMs = 0; //The cached millis() of the next deadline (see isDeadlineDue())
+    uint8_t clickCounter = 0;
+    uint8_t prevClickCount = 0;
+    uint16_t longPressCounter = 0;
+    #ifndef INPUT_EVENTS_COMPACT
+    uint32_t releaseUs = 0; //eventTimestamp() of the last release, the trigger of click events
+    #endif
 
     protected:
 
+    /**
+     * @brief The class passed to callbacks (see SelfT).
+     */
+    typedef typename InputSelfType<SelfT, BasicEventButton>::type Self;
+
     #if defined(FUNCTIONAL_SUPPORTED)
         /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
+         * @brief If <code>std::function</code> is supported, this creates the callback type (a heap free InputDelegate by default).
          */
-        typedef std::function<void(InputEventType et, EventButton &ie)> CallbackFunction;
+        typedef InputCallback<void(InputEventType et, Self &ie)> CallbackFunction;
     #else
         /**
          * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
          */
-        typedef void (*CallbackFunction)(InputEventType et, EventButton &);
+        typedef void (*CallbackFunction)(InputEventType et, Self &);
     #endif
 
     /**
@@ -54,6 +113,7 @@ class EventButton : public EventInputBase {
     CallbackFunction callbackFunction = nullptr;
 
 
+
     public:
 
     ///@{ 
@@ -65,14 +125,14 @@ class EventButton : public EventInputBase {
      * 
      * @param buttonPin Any type of pin and optionally use the default debouncer (default true). By default button contact should pull down to to GND when pressed. This behaviour can be reversed with setPressedState()
      */
-    EventButton(byte buttonPin, bool useDefaultDebouncer=true);
+    BasicEventButton(byte buttonPin, bool useDefaultDebouncer=true);
 
     /**
      * @brief Construct a new EventButton with a PinAdapter and optionally use the default debouncer
      * 
      * @param pinAdapter 
      */
-    EventButton(PinAdapter* _pinAdapter, bool useDefaultDebouncer=true);
+    BasicEventButton(PinT* _pinAdapter, bool useDefaultDebouncer=true);
 
     /**
      * @brief Construct a new EventButton with a PinAdapter and a DebounceAdapter
@@ -80,7 +140,17 @@ class EventButton : public EventInputBase {
      * @param pinAdapter 
      * @param debounceAdapter 
      */
-    EventButton(PinAdapter* _pinAdapter, DebounceAdapter* debounceAdapter);
+    BasicEventButton(PinT* _pinAdapter, DebounceT* debounceAdapter);
+
+    /**
+     * @brief Destroy the EventButton and any adapters it created (adapters you passed in are not destroyed).
+     */
+    ~BasicEventButton();
+
+    /// \cond DO_NOT_DOCUMENT
+    BasicEventButton(const BasicEventButton&) = delete; // Owned adapters cannot be shared
+    BasicEventButton& operator=(const BasicEventButton&) = delete;
+    /// \endcond
 
     ///@}
 
@@ -121,9 +191,9 @@ class EventButton : public EventInputBase {
      */
     #if defined(FUNCTIONAL_SUPPORTED)
     template <typename T>
-    void setCallback(T* instance, void (T::*method)(InputEventType, EventButton&)) {
+    void setCallback(T* instance, void (T::*method)(InputEventType, Self&)) {
         // Wrap the method call in a lambda
-        callbackFunction = [instance, method](InputEventType et, EventButton& ie) {
+        callbackFunction = [instance, method](InputEventType et, Self& ie) {
             (instance->*method)(et, ie); // Call the member function on the instance
         };
         callbackIsSet = true;
@@ -137,12 +207,38 @@ class EventButton : public EventInputBase {
      */
     void unsetCallback() override;
 
+    /**
+     * @brief Set a handler for a single event type. It is called instead of the callback for that event.
+     * 
+     * @details Events without a handler are passed to the callback (if set), so there is no need for a 
+     * <code>switch</code> in the callback. If no callback is set, events without a handler are ignored.
+     * Up to INPUT_EVENTS_HANDLERS handlers can be set - the handler table is created the first time on() is called 
+     * (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     * 
+     * @param et The event, eg <code>InputEventType::CLICKED</code>
+     * @param handler A function of type <code>EventButton::CallbackFunction</code> or nullptr to remove the handler
+     * @return false if the handler table is full
+     */
+    bool on(InputEventType et, CallbackFunction handler) { return setHandler(et, handler); }
+
     /**
      * @brief Update the state from the pin input.
      * 
      * @details *Must* be called from within <code>loop()</code>
      */
-    void update();
+    void update(uint32_t nowMs) override;
+    using EventInputBase::update;
+
+    /**
+     * @brief The number of milliseconds until the next LONG_PRESS, click (CLICKED, DOUBLE_CLICKED, 
+     * MULTI_CLICKED or LONG_CLICKED) or IDLE event is due, or a pending debounce completes.
+     * 
+     * @details While nothing is pending, update() only reads the pin.
+     * 
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs(uint32_t nowMs) override;
+    using EventInputBase::nextDeadlineMs;
 
     ///@}
 
@@ -190,6 +286,17 @@ class EventButton : public EventInputBase {
 
     ///@}
 
+    /**
+     * @brief End the current click without firing its click event, so the next press starts a new click.
+     * @details Used by EventChord so the press of a chord is not counted as a click of its buttons.
+     */
+    void cancelClick() {
+        clickFired = true;
+        clickCounter = 0;
+        longPressCounter = 0;
+        invalidateDeadline();
+    }
+
 
     ///@{
     /**
@@ -200,7 +307,10 @@ class EventButton : public EventInputBase {
      * 
      * @param repeat Pass true to repeat, false to not repeat.
      */
-    void enableLongPressRepeat(bool repeat=true) { repeatLongPress = repeat; }
+    void enableLongPressRepeat(bool repeat=true) { 
+        timing().repeatLongPress = repeat; 
+        invalidateDeadline();
+    }
 
     /**
      * @brief Set the number of milliseconds that define the *first* long click duration.
@@ -208,7 +318,10 @@ class EventButton : public EventInputBase {
      * 
      * @param longDurationMs Default 750ms
      */
-    void setLongClickDuration(uint16_t longDurationMs=750) { longClickDuration = longDurationMs; }
+    void setLongClickDuration(uint16_t longDurationMs=750) { 
+        timing().longClickDuration = longDurationMs; 
+        invalidateDeadline();
+    }
 
     /**
      * @brief Set the number of milliseconds that define the *subbsequent* long click intervals.
@@ -216,22 +329,42 @@ class EventButton : public EventInputBase {
     * 
      * @param intervalMs The interval in milliseconds (default is 500ms).
      */
-    void setLongPressInterval(uint16_t intervalMs=500) { longPressInterval = intervalMs; }
+    void setLongPressInterval(uint16_t intervalMs=500) { 
+        timing().longPressInterval = intervalMs; 
+        invalidateDeadline();
+    }
 
     /**
      * @brief Set the multi click interval.
      * 
      * @param intervalMs The interval in milliseconds between double, triple or multi clicks
      */
-    void setMultiClickInterval(uint16_t intervalMs=250) { multiClickInterval = intervalMs; }
+    void setMultiClickInterval(uint16_t intervalMs=250) { 
+        timing().multiClickInterval = intervalMs; 
+        invalidateDeadline();
+    }
+
+    #ifdef INPUT_EVENTS_COMPACT
+    /**
+     * @brief Compact mode only: point this button at a different set of timings.
+     * @details In compact mode the timing setters above change ButtonTimings::shared (and so *every* button using it). 
+     * To give a group of buttons different timings, create a ButtonTimings and pass it to each button.
+     * 
+     * @param buttonTimings Must remain valid for the life of the button.
+     */
+    void setTimings(ButtonTimings* buttonTimings) {
+        timings = buttonTimings;
+        invalidateDeadline();
+    }
+    #endif
 
     /**
      * @brief Set the debouncer.
-     * **Note:** When planning to use `setDebouncer()` you must ensure `useDefaultDebouncer` is set to `false` in the button or switch constructor. *Previously set debouncers are not deleted*.
+     * **Note:** A debouncer created by the EventButton (ie the default debouncer) is destroyed. Debouncers you have set are not deleted.
      * 
      * @param debounceAdapter 
      */
-    void setDebouncer(DebounceAdapter* debounceAdapter);
+    void setDebouncer(DebounceT* debounceAdapter);
 
     /**
      * @brief Set the DebounceAdapter debounce interval. Default is 10ms
@@ -262,7 +395,12 @@ class EventButton : public EventInputBase {
      * 
      * @param et Enum of type <code>InputEventType</code>
      */
-    void invoke(InputEventType et) override;
+    void invoke(InputEventType et) override { invokeHandler(et, callbackFunction, static_cast<Self&>(*this)); }
+
+    /**
+     * @brief Override of the <code>EventInputBase::eventPayload()</code> virtual method. Returns clickCount().
+     */
+    int16_t eventPayload(InputEventType /*et*/) override { return clickCount(); }
 
 
     /**
@@ -275,16 +413,46 @@ class EventButton : public EventInputBase {
      * @brief Change the button state and flag as changed
      * 
      * @param newState 
+     * @param ms The millis() of the change
+     */
+    void changeState(bool newState, uint32_t ms);
+
+    /**
+     * @brief Fire the PRESSED or RELEASED event after a change of state
+     */
+    void onStateChanged();
+
+    /**
+     * @brief Fire LONG_PRESS and click events that are due at the passed time
+     * 
+     * @param ms The millis() to check the timers against
+     */
+    void fireTimedEvents(uint32_t ms);
+
+    /**
+     * @brief Process the edges captured by the PinAdapter (if capturesEdges() is true)
+     * 
+     * @param nowMs The time of this update()
+     */
+    void processEdges(uint32_t nowMs);
+
+    /**
+     * @brief Debounce (if a debouncer is set) a pin state at a known time and change state if required
+     * 
+     * @param pinState The (raw) pin state
+     * @param ms The millis() when the pin was in this state
+     * @param held The captured edge the state started at, to time the change from (nullptr if there is none)
      */
-    void changeState(bool newState);
+    void applyPinState(bool pinState, uint32_t ms, const PinEdge* held);
 
     /**
      * @brief Returns true if either pinAdapter, press() or release() changed the button state
      * 
+     * @param nowMs The time of this update()
      * @return true 
      * @return false 
      */
-    bool changedState();
+    bool changedState(uint32_t nowMs);
 
     /**
      * @brief Returns true if pinAdapter read() has changed since last call
@@ -294,6 +462,29 @@ class EventButton : public EventInputBase {
      */
     bool changedPinState();
 
+    /**
+     * @brief Read the pin via a PinAdapter (virtual).
+     */
+    bool readPin(PinAdapter* p) { return p->read(); }
+
+    /**
+     * @brief Read the pin with a concrete adapter type. The call is qualified so it is not virtual and can be 
+     * inlined (overrides in classes derived from PinT are not called).
+     */
+    template <class P>
+    bool readPin(P* p) { return p->P::read(); }
+
+    /**
+     * @brief Read the debounced pin state via a DebounceAdapter (virtual, the debouncer reads the pin).
+     */
+    bool readDebounced(DebounceAdapter* d, uint32_t nowMs) { return d->read(nowMs); }
+
+    /**
+     * @brief Read the debounced pin state with concrete adapter types so both calls can be inlined.
+     */
+    template <class D>
+    bool readDebounced(D* d, uint32_t nowMs) { return d->D::debounce(readPin(pinAdapter), nowMs); }
+
     /**
      * @brief Returns true if state has changed and previous state is pressedState
      * 
@@ -312,46 +503,331 @@ class EventButton : public EventInputBase {
 
     private:
 
-    PinAdapter* pinAdapter;
-    DebounceAdapter* debouncer;
-
-    bool pressedState = LOW; //The state that represents 'pressed'
+    /**
+     * @brief All constructors delegate to this one to initialise the flags (bit fields cannot have default member initialisers).
+     */
+    BasicEventButton(PinT* _pinAdapter, DebounceT* debounceAdapter, bool ownsPin, bool ownsDebounce);
 
-    //state
+    /**
+     * @brief The timing settings - shared in compact mode.
+     */
+    #ifdef INPUT_EVENTS_COMPACT
+    ButtonTimings& timing() { return *timings; }
+    #else
+    ButtonTimings& timing() { return timings; }
+    #endif
 
-    bool currentPinState = HIGH;
-    bool previousPinState = HIGH;
+    /**
+     * @brief How long to wait for another click before a click is fired. If only per-event handlers are 
+     * set (see on()) and none of them handle DOUBLE_CLICKED or MULTI_CLICKED, CLICKED fires without waiting.
+     */
+    uint16_t multiClickWait() {
+        if ( hasEventHandlers() 
+                && !isEventHandled(InputEventType::DOUBLE_CLICKED) 
+                && !isEventHandled(InputEventType::MULTI_CLICKED) ) {
+            return 0;
+        }
+        return timing().multiClickInterval;
+    }
 
-    bool currentState = HIGH; //set via PinAdapter->read()
-    bool previousState = HIGH;
-    bool stateChanged = false;
-    uint32_t stateChangeLastTime;
-    uint32_t durationOfPreviousState;
+    PinT* pinAdapter;
+    DebounceT* debouncer = nullptr;
 
-    uint8_t clickCounter = 0;
-    uint8_t prevClickCount = 0;
-    bool clickFired = true;
 
     //setup
-    uint16_t multiClickInterval = 250;
-    uint16_t longClickDuration = 750;
-    bool repeatLongPress = true;
-    uint16_t longPressInterval = 500;
-    uint16_t longPressCounter = 0;
-
-
+    #ifdef INPUT_EVENTS_COMPACT
+    ButtonTimings* timings = &ButtonTimings::shared;
+    #else
+    ButtonTimings timings;
+    #endif
 
 };
 
 
-#endif
+template <class PinT, class DebounceT, class SelfT>
+BasicEventButton<PinT, DebounceT, SelfT>::BasicEventButton(byte pin, bool useDefaultDebouncer /*=true*/)
+    : BasicEventButton(AdapterPool::create<GpioPinAdapter>(pin), nullptr, true, false)
+    { 
+        if ( useDefaultDebouncer ) {
+            debouncer = AdapterPool::create<FoltmanDebounceAdapter>(pinAdapter);
+            ownsDebouncer = true;
+        }
+    }
 
+template <class PinT, class DebounceT, class SelfT>
+BasicEventButton<PinT, DebounceT, SelfT>::BasicEventButton(PinT* _pinAdapter, bool useDefaultDebouncer /*=true*/)
+    : BasicEventButton(_pinAdapter, nullptr, false, false)
+    { 
+        if ( useDefaultDebouncer ) {
+            debouncer = AdapterPool::create<FoltmanDebounceAdapter>(pinAdapter);
+            ownsDebouncer = true;
+        }
+    }
 
+template <class PinT, class DebounceT, class SelfT>
+BasicEventButton<PinT, DebounceT, SelfT>::BasicEventButton(PinT* _pinAdapter, DebounceT* debounceAdapter) 
+    : BasicEventButton(_pinAdapter, debounceAdapter, false, false)
+    { 
+        debouncer->setPinAdapter(pinAdapter);
+    }
 
+template <class PinT, class DebounceT, class SelfT>
+BasicEventButton<PinT, DebounceT, SelfT>::BasicEventButton(PinT* _pinAdapter, DebounceT* debounceAdapter, bool ownsPin, bool ownsDebounce) 
+    : ownsPinAdapter(ownsPin),
+      ownsDebouncer(ownsDebounce),
+      pressedState(LOW),
+      currentPinState(HIGH),
+      previousPinState(HIGH),
+      currentState(HIGH),
+      previousState(HIGH),
+      stateChanged(false),
+      edgeCapture(false),
+      edgeState(HIGH),
+      clickFired(true),
+      pinAdapter(_pinAdapter),
+      debouncer(debounceAdapter)
+    { }
+
+template <class PinT, class DebounceT, class SelfT>
+BasicEventButton<PinT, DebounceT, SelfT>::~BasicEventButton() {
+    if ( ownsDebouncer ) AdapterPool::destroy(debouncer);
+    if ( ownsPinAdapter ) AdapterPool::destroy(pinAdapter);
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::begin() {
+    pinAdapter->begin();
+    if ( debouncer ) {
+        debouncer->begin();
+    }
+    changedState(InputClock::ms()); //Use to read/set inital state
+    stateChanged = false;
+    edgeCapture = pinAdapter->capturesEdges();
+    edgeState = pinAdapter->read();
+    registerInput();
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::unsetCallback() {
+    callbackFunction = nullptr;
+    EventInputBase::unsetCallback();
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::update(uint32_t nowMs) {
+    if (_enabled) {
+        updateMs = nowMs;
+        //button update (fires pressed/released callbacks)
+        if ( edgeCapture ) {
+            processEdges(nowMs);
+        } else if ( changedState(nowMs) ) {
+            onStateChanged();
+        }
+        if ( currentState != pressedState && !isDeadlineDue(nowMs, deadlineAtMs) ) {
+            // No change (changes invalidate the deadline) and no click or idle timer due
+            return;
+        }
+        eventUs = InputClock::us();
+        fireTimedEvents(nowMs);
+        EventInputBase::update(nowMs);
+        scheduleDeadline(nowMs, deadlineAtMs);
+    }
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::onStateChanged() {
+    if (pressing()) {
+        invoke(InputEventType::PRESSED);
+    } else if (releasing()) {
+        #ifndef INPUT_EVENTS_COMPACT
+        releaseUs = eventUs;
+        #endif
+        clickFired = false;
+        clickCounter++;
+        prevClickCount = clickCounter;
+        invoke(InputEventType::RELEASED);
+    }
+    stateChanged = false;
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::fireTimedEvents(uint32_t ms) {
+    uint32_t duration = (InputTicks)(ms - stateChangeLastTime);
+    //fire long press callbacks
+    if (currentState == pressedState) {
+        resetIdleTimer(updateMs);
+        if (duration > (uint16_t)(timing().longClickDuration + (longPressCounter * timing().longPressInterval ))) {
+            longPressCounter++;
+            if ((timing().repeatLongPress || longPressCounter == 1) ) {
+                invoke(InputEventType::LONG_PRESS);
+            }
+        }
+    }
+    //fire button click callbacks
+    if (!clickFired && currentState != pressedState && duration > multiClickWait()) {
+        clickFired = true;
+        #ifdef INPUT_EVENTS_COMPACT
+        eventUs -= duration * 1000UL; // Timed from the release, to the millisecond
+        #else
+        eventUs = releaseUs;
+        #endif
+        if (previousDuration() > timing().longClickDuration) {
+            clickCounter = 0;
+            prevClickCount = 1;
+            invoke(InputEventType::LONG_CLICKED);
+            longPressCounter = 0;
+        } else {
+            if ( clickCounter == 1 ) {
+                invoke(InputEventType::CLICKED);
+            } else if (clickCounter == 2 ) {
+                invoke(InputEventType::DOUBLE_CLICKED);
+            } else {
+                invoke(InputEventType::MULTI_CLICKED);
+            }
+            clickCounter = 0;
+        }
+    }
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::processEdges(uint32_t nowMs) {
+    PinEdge edge;
+    PinEdge held; // The edge the current pin state started at
+    bool hasHeld = pinAdapter->lastEdge(held);
+    while ( pinAdapter->popEdge(edge) ) {
+        eventUs = edge.us;
+        fireTimedEvents(edge.ms); // Anything due before this edge
+        applyPinState(edgeState, edge.ms, hasHeld ? &held : nullptr); // The previous state was held until the edge
+        applyPinState(edge.state, edge.ms, &edge);
+        edgeState = edge.state;
+        held = edge;
+        hasHeld = true;
+    }
+    applyPinState(edgeState, nowMs, hasHeld ? &held : nullptr); // Complete any pending debounce
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::applyPinState(bool pinState, uint32_t ms, const PinEdge* held) {
+    bool state = pinState;
+    if ( debouncer ) {
+        state = debouncer->debounce(pinState, ms);
+        ms = debouncer->changedAtMs();
+    }
+    if ( state != currentState ) {
+        if ( held ) setEventTime(ms, held->ms, held->us); // Exact if the change was at the held edge
+        changeState(state, ms);
+        onStateChanged();
+    }
+}
+
+template <class PinT, class DebounceT, class SelfT>
+uint32_t BasicEventButton<PinT, DebounceT, SelfT>::nextDeadlineMs(uint32_t nowMs) {
+    uint32_t next = EventInputBase::nextDeadlineMs(nowMs);
+    if ( !_enabled ) return next;
+    if ( debouncer ) next = min(next, debouncer->msUntilSettled(nowMs));
+    uint32_t duration = (InputTicks)(nowMs - stateChangeLastTime);
+    if ( currentState == pressedState ) {
+        // LONG_PRESS fires when the duration exceeds the threshold
+        uint16_t threshold = (uint16_t)(timing().longClickDuration + (longPressCounter * timing().longPressInterval ));
+        next = min(next, duration > threshold ? 0 : threshold + 1 - duration);
+    } else if ( !clickFired ) {
+        // The click type is decided when the duration exceeds the multi click interval
+        uint16_t wait = multiClickWait();
+        next = min(next, duration > wait ? 0 : wait + 1 - duration);
+    }
+    return next;
+}
+
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::onDisabled() {
+    //Reset button state
+    clickCounter = 0;
+    longPressCounter = 0;
+    invalidateDeadline();
+    invoke(InputEventType::DISABLED);
+}
+
+template <class PinT, class DebounceT, class SelfT>
+bool BasicEventButton<PinT, DebounceT, SelfT>::changedState(uint32_t nowMs) {
+    if ( debouncer ) {
+        currentPinState = readDebounced(debouncer, nowMs);
+    } else {
+        currentPinState = readPin(pinAdapter);
+    }
+    if ( changedPinState() && currentPinState != currentState ) {
+            // Stamp with the raw edge that started the change (the debounce interval ago)
+            setEventTime(debouncer ? debouncer->changedAtMs() : nowMs, nowMs, InputClock::us());
+            changeState(currentPinState, nowMs);
+    }
+    return stateChanged;
+}
+
+template <class PinT, class DebounceT, class SelfT>
+bool BasicEventButton<PinT, DebounceT, SelfT>::changedPinState() {
+    if ( currentPinState == previousPinState ) return false;
+    previousPinState = currentPinState;
+    return true;
+}
+
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::changeState(bool newState, uint32_t ms) {
+    previousState = currentState;
+    currentState = newState;
+    stateChanged = true;
+    durationOfPreviousState = (InputTicks)(ms - stateChangeLastTime);
+    stateChangeLastTime = ms;
+    invalidateDeadline();
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventButton<PinT, DebounceT, SelfT>::setDebouncer(DebounceT* debounceAdapter) {
+    if ( ownsDebouncer && debounceAdapter != debouncer ) {
+        AdapterPool::destroy(debouncer);
+        ownsDebouncer = false;
+    }
+    debouncer = debounceAdapter;
+    if (debouncer) { //Can pass nullptr to unset?
+        debouncer->setPinAdapter(pinAdapter);
+        debouncer->begin();
+    }
+}
 
+template <class PinT, class DebounceT, class SelfT>
+bool BasicEventButton<PinT, DebounceT, SelfT>::setDebounceInterval(uint16_t intervalMs) { 
+    if ( debouncer ) {
+        debouncer->setDebounceInterval(intervalMs);
+        return true;
+    }
+    return false;
+}
 
+template <class PinT, class DebounceT, class SelfT>
+uint32_t BasicEventButton<PinT, DebounceT, SelfT>::currentDuration() { return (InputTicks)(InputClock::ms() - stateChangeLastTime); }
 
+class EventButton;
 
+// Compiled once in EventButton.cpp rather than in every sketch
+extern template class BasicEventButton<PinAdapter, DebounceAdapter, EventButton>;
 
+/**
+ * @brief An EventButton that works with any PinAdapter and DebounceAdapter (via virtual methods).
+ */
+class EventButton : public BasicEventButton<PinAdapter, DebounceAdapter, EventButton> {
+    public:
+    using BasicEventButton::BasicEventButton;
+};
 
+/**
+ * @brief An EventButton with a GpioPinAdapter and the default FoltmanDebounceAdapter as concrete types, 
+ * so reading and debouncing the pin can be inlined into update(). 
+ * 
+ * @details Construct with a pin number as for EventButton.
+ */
+class GpioEventButton : public BasicEventButton<GpioPinAdapter, FoltmanDebounceAdapter, GpioEventButton> {
+    public:
+    using BasicEventButton::BasicEventButton;
+};
 
+#endif
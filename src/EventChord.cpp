@@ -0,0 +1,253 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "EventChord.h"
+#include "InputRegistry.h"
+
+
+EventChord::EventChord(uint16_t windowMs /*=50*/)
+    : chordWindowMs(windowMs) {}
+
+EventChord::~EventChord() {
+    // Buttons destroyed before the chord have already removed themselves from their listeners
+    for ( uint8_t i = 0; i < memberCount; i++ ) {
+        EventButton* button = memberAt(i);
+        if ( button == nullptr ) continue;
+        #ifndef FUNCTIONAL_SUPPORTED
+        button->setOwner(nullptr);
+        #endif
+        uint16_t bit = 1U << i;
+        if ( autoRegisteredMembers & bit ) {
+            button->enableAutoRegister(true);
+            if ( begunMembers & bit ) InputRegistry::add(button);
+        }
+    }
+}
+
+int8_t EventChord::addButton(EventButton& button) {
+    if ( memberCount >= INPUT_EVENTS_CHORD_MEMBERS || indexOf(button) >= 0 ) return -1;
+    uint16_t bit = 1U << memberCount;
+    if ( button.isAutoRegisterEnabled() ) autoRegisteredMembers |= bit;
+    if ( InputRegistry::contains(&button) ) begunMembers |= bit;
+    // Only the EventChord is registered, it updates its buttons
+    button.enableAutoRegister(false);
+    InputRegistry::remove(&button);
+    InputListener& listener = members[memberCount];
+    #ifdef FUNCTIONAL_SUPPORTED
+    listener.setFunction([this](InputEventType et, EventInputBase &btn) { onInputCallback(et, static_cast<EventButton&>(btn)); });
+    #else
+    button.setOwner(this);
+    listener.setFunction(EventChord::buttonListener);
+    #endif
+    button.addListener(&listener);
+    return memberCount++;
+}
+
+int8_t EventChord::addChord(uint16_t mask) {
+    uint16_t valid = (uint16_t)((1UL << memberCount) - 1);
+    // A chord needs at least two members that have been added
+    if ( chordCount >= INPUT_EVENTS_CHORDS || (mask & ~valid) || (mask & (mask - 1)) == 0 ) return -1;
+    chords[chordCount] = mask;
+    chordMembers |= mask;
+    return chordCount++;
+}
+
+int8_t EventChord::addChord(EventButton& a, EventButton& b) {
+    uint16_t ma = memberMask(a);
+    uint16_t mb = memberMask(b);
+    return ( ma && mb ) ? addChord(ma | mb) : -1;
+}
+
+int8_t EventChord::addChord(EventButton& a, EventButton& b, EventButton& c) {
+    uint16_t ma = memberMask(a);
+    uint16_t mb = memberMask(b);
+    uint16_t mc = memberMask(c);
+    return ( ma && mb && mc ) ? addChord(ma | mb | mc) : -1;
+}
+
+uint16_t EventChord::memberMask(EventButton& button) {
+    int8_t i = indexOf(button);
+    return i < 0 ? 0 : (uint16_t)(1U << i);
+}
+
+int8_t EventChord::indexOf(EventButton& button) {
+    for ( uint8_t i = 0; i < memberCount; i++ ) {
+        if ( memberAt(i) == &button ) return i;
+    }
+    return -1;
+}
+
+void EventChord::begin() {
+    for ( uint8_t i = 0; i < memberCount; i++ ) {
+        if ( EventButton* button = memberAt(i) ) button->begin();
+    }
+    begunMembers = (uint16_t)((1UL << memberCount) - 1);
+    registerInput();
+}
+
+void EventChord::unsetCallback() {
+    callbackFunction = nullptr;
+    EventInputBase::unsetCallback();
+}
+
+void EventChord::update(uint32_t nowMs) {
+    updateMs = nowMs;
+    for ( uint8_t i = 0; i < memberCount; i++ ) {
+        if ( EventButton* button = memberAt(i) ) {
+            button->update(nowMs);
+        } else {
+            // A destroyed button is released and can no longer be held or suppressed
+            uint16_t bit = 1U << i;
+            pressedMembers &= ~bit;
+            suppressedMembers &= ~bit;
+            if ( activeChord >= 0 && (chords[activeChord] & bit) ) releaseChord();
+        }
+    }
+    if ( heldMembers && (uint32_t)(nowMs - windowStartMs) >= chordWindowMs ) {
+        matchChord(true);
+    }
+    EventInputBase::update(nowMs);
+}
+
+uint32_t EventChord::nextDeadlineMs(uint32_t nowMs) {
+    uint32_t ms = EventInputBase::nextDeadlineMs(nowMs);
+    for ( uint8_t i = 0; i < memberCount; i++ ) {
+        if ( EventButton* button = memberAt(i) ) ms = min(ms, button->nextDeadlineMs(nowMs));
+    }
+    if ( heldMembers ) {
+        uint32_t elapsed = nowMs - windowStartMs;
+        ms = min(ms, elapsed >= chordWindowMs ? (uint32_t)0 : chordWindowMs - elapsed);
+    }
+    return ms;
+}
+
+int16_t EventChord::eventPayload(InputEventType /*et*/) {
+    return currentMember < 0 ? lastChord : MEMBER_PAYLOAD + currentMember;
+}
+
+void EventChord::onEnabled() {
+    for ( uint8_t i = 0; i < memberCount; i++ ) {
+        if ( EventButton* button = memberAt(i) ) button->enable();
+    }
+    invoke(InputEventType::ENABLED);
+}
+
+void EventChord::onDisabled() {
+    for ( uint8_t i = 0; i < memberCount; i++ ) {
+        if ( EventButton* button = memberAt(i) ) button->enable(false);
+    }
+    heldMembers = 0;
+    heldCount = 0;
+    currentMember = -1;
+    invoke(InputEventType::DISABLED);
+}
+
+void EventChord::onInputCallback(InputEventType et, EventButton & button) {
+    //Only fire ENABLED, DISABLED and IDLE events from EventChord
+    if ( et <= InputEventType::IDLE ) return;
+    int8_t index = indexOf(button);
+    if ( index < 0 ) return;
+    uint16_t bit = 1U << index;
+
+    if ( et == InputEventType::PRESSED ) {
+        pressedMembers |= bit;
+    } else if ( et == InputEventType::RELEASED ) {
+        pressedMembers &= ~bit;
+        if ( activeChord >= 0 && (chords[activeChord] & bit) ) {
+            eventUs = button.eventTimestamp();
+            releaseChord();
+        }
+    }
+
+    if ( suppressedMembers & bit ) {
+        // The chord's press ends with the member's release and is not one of the member's clicks,
+        // so a click straight after the chord is a single click
+        if ( et == InputEventType::RELEASED ) {
+            button.cancelClick();
+            suppressedMembers &= ~bit;
+        }
+        return;
+    }
+
+    if ( et == InputEventType::PRESSED && (chordMembers & bit) ) {
+        if ( heldMembers == 0 ) windowStartMs = updateMs;
+        heldMembers |= bit;
+        heldOrder[heldCount] = index;
+        heldUs[heldCount++] = button.eventTimestamp();
+        matchChord(false);
+        return;
+    }
+
+    // Anything else from a held member (eg a quick RELEASED) ends the window
+    if ( heldMembers & bit ) fireHeld();
+    eventUs = button.eventTimestamp();
+    fireMember(et, index);
+}
+
+void EventChord::matchChord(bool windowClosed) {
+    uint16_t pressed = pressedMembers & chordMembers;
+    int8_t match = -1;
+    bool partial = false;
+    // A chord can only match if all its members' PRESSED events are held
+    if ( (pressed & ~heldMembers) == 0 ) {
+        for ( uint8_t c = 0; c < chordCount; c++ ) {
+            if ( chords[c] == pressed ) {
+                match = c;
+            } else if ( (pressed & ~chords[c]) == 0 ) {
+                partial = true; // More presses could still match a larger chord
+            }
+        }
+    }
+    if ( match >= 0 && (windowClosed || !partial) ) {
+        pressChord(match);
+    } else if ( windowClosed || !partial ) {
+        fireHeld();
+    }
+}
+
+void EventChord::pressChord(int8_t c) {
+    // The held PRESSED events are dropped
+    heldMembers = 0;
+    heldCount = 0;
+    suppressedMembers |= chords[c];
+    activeChord = c;
+    lastChord = c;
+    currentMember = -1;
+    chordPressedMs = updateMs;
+    eventUs = InputClock::us();
+    invoke(InputEventType::PRESSED);
+}
+
+void EventChord::releaseChord() {
+    activeChord = -1;
+    currentMember = -1;
+    releasedMs = updateMs;
+    invoke(InputEventType::RELEASED);
+    if ( (uint32_t)(releasedMs - chordPressedMs) < longClickMs ) {
+        invoke(InputEventType::CLICKED);
+    } else {
+        invoke(InputEventType::LONG_CLICKED);
+    }
+}
+
+void EventChord::fireHeld() {
+    uint8_t count = heldCount;
+    heldMembers = 0;
+    heldCount = 0;
+    for ( uint8_t i = 0; i < count; i++ ) {
+        if ( memberAt(heldOrder[i]) == nullptr ) continue;
+        eventUs = heldUs[i];
+        fireMember(InputEventType::PRESSED, heldOrder[i]);
+    }
+}
+
+void EventChord::fireMember(InputEventType et, int8_t index) {
+    currentMember = index;
+    invoke(et);
+    currentMember = -1;
+}
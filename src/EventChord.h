@@ -0,0 +1,349 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+
+#ifndef EVENT_CHORD_H
+#define EVENT_CHORD_H
+
+#include "Arduino.h"
+#include "EventButton.h"
+#include "InputListener.h"
+
+#ifndef INPUT_EVENTS_CHORD_MEMBERS
+/**
+ * @brief The number of EventButtons an EventChord can hold (at most 16). Can be overridden with a build flag.
+ */
+#define INPUT_EVENTS_CHORD_MEMBERS 8
+#endif
+
+#ifndef INPUT_EVENTS_CHORDS
+/**
+ * @brief The number of chords an EventChord can define. Can be overridden with a build flag.
+ */
+#define INPUT_EVENTS_CHORDS 8
+#endif
+
+static_assert(INPUT_EVENTS_CHORD_MEMBERS <= 16, "An EventChord can hold at most 16 buttons");
+
+/**
+ * @brief The EventChord class fires chord events when two or more of its EventButtons are pressed together, eg A+B.
+ * @details The pressed state of each member button is held as a bit and each chord is a mask of member bits,
+ * so matching a chord is a single compare per chord (done only when a member is pressed).
+ *
+ * A member's <code>PRESSED</code> event is held back for the chord window (default 50ms). If the pressed members
+ * match a chord within the window, the held events are dropped and the chord's <code>PRESSED</code> fires. The
+ * members' events are then suppressed until each is released (ie their <code>LONG_PRESS</code> and
+ * <code>RELEASED</code> are not fired) and the press is not counted as a click of the member. If no chord
+ * matches, the held events are fired late and the members behave as normal buttons.
+ *
+ * The EventChord receives its members' events through an InputListener, so a member can be destroyed before
+ * the chord (it is then dropped from the chord).
+ *
+ * Member events are fired from the EventChord's callback: member() returns the button (and chord() returns -1).
+
+    The following InputEventTypes are fired by EventChord:
+    - InputEventType::ENABLED - fired when the input is enabled.
+    - InputEventType::DISABLED - fired when the input is disabled.
+    - InputEventType::IDLE - fired after no other event (except <code>ENABLED</code> & <code>DISABLED</code>) has been fired for a specified time. Each input can define its own idle timeout. Default is 10 seconds.
+    - InputEventType::PRESSED - fired when a chord is pressed (or, with member() set, a member button is pressed).
+    - InputEventType::RELEASED - fired when the first button of a pressed chord is released.
+    - InputEventType::CLICKED - fired after a chord's <code>RELEASED</code> if it was held for less than the long click duration.
+    - InputEventType::LONG_CLICKED - fired after a chord's <code>RELEASED</code> if it was held for the long click duration or more.
+    - All the EventButton events of member buttons that are not part of a chord, with member() set.
+
+ *
+ */
+class EventChord : public EventInputBase {
+
+protected:
+
+    #if defined(FUNCTIONAL_SUPPORTED)
+        /**
+         * @brief If <code>std::function</code> is supported, this creates the callback type (a heap free InputDelegate by default).
+         */
+        typedef InputCallback<void(InputEventType et, EventChord &ie)> CallbackFunction;
+    #else
+        /**
+         * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
+         */
+        typedef void (*CallbackFunction)(InputEventType et, EventChord &);
+    #endif
+
+    /**
+     * @brief The callback function member.
+     */
+    CallbackFunction callbackFunction = nullptr;
+
+
+public:
+
+    /**
+     * @brief Added to the member index for the eventPayload() of member events (chord events use the chord index).
+     */
+    static const int16_t MEMBER_PAYLOAD = 0x100;
+
+    ///@{
+    /**
+     * @name Constructors
+     */
+    /**
+     * @brief Construct an EventChord. Add the buttons with addButton() and the chords with addChord().
+     *
+     * @param windowMs The time within which all the buttons of a chord must be pressed
+     */
+    EventChord(uint16_t windowMs=50);
+
+    /**
+     * @brief Destroy the EventChord, giving its remaining buttons back their InputRegistry registration.
+     */
+    ~EventChord();
+
+    /// \cond DO_NOT_DOCUMENT
+    EventChord(const EventChord&) = delete; // Owns the handler table and the member listeners
+    EventChord& operator=(const EventChord&) = delete;
+    /// \endcond
+
+    ///@}
+
+    ///@{
+    /**
+     * @name Defining Chords
+     */
+
+    /**
+     * @brief Add a button to the chord.
+     *
+     * @details The EventChord takes over the button: it listens to the button's events, removes it from the
+     * InputRegistry and calls its begin() and update(). Handle the button's events in the EventChord's callback.
+     * When the EventChord is destroyed the button is registered again (if it was before).
+     *
+     * @param button A previously created EventButton
+     * @return int8_t The member index (its bit in a chord mask is <code>1 << index</code>) or -1 if full or already added
+     */
+    int8_t addButton(EventButton& button);
+
+    /**
+     * @brief Define a chord from a mask of member bits (see memberMask()).
+     *
+     * @param mask The members that must be pressed together. Must have at least two bits set.
+     * @return int8_t The chord index or -1 if full or the mask is invalid
+     */
+    int8_t addChord(uint16_t mask);
+
+    /**
+     * @brief Define a chord of two buttons (added with addButton()).
+     *
+     * @return int8_t The chord index or -1
+     */
+    int8_t addChord(EventButton& a, EventButton& b);
+
+    /**
+     * @brief Define a chord of three buttons (added with addButton()).
+     *
+     * @return int8_t The chord index or -1
+     */
+    int8_t addChord(EventButton& a, EventButton& b, EventButton& c);
+
+    /**
+     * @brief The chord mask bit of a button.
+     *
+     * @return uint16_t The bit or 0 if the button has not been added
+     */
+    uint16_t memberMask(EventButton& button);
+
+    /**
+     * @brief Set the time within which all the buttons of a chord must be pressed.
+     * @details Member <code>PRESSED</code> events are delayed by up to this time.
+     *
+     * @param windowMs Default is 50ms
+     */
+    void setChordWindow(uint16_t windowMs=50) { chordWindowMs = windowMs; }
+
+    /**
+     * @brief Set the time a chord must be held for <code>LONG_CLICKED</code> (instead of <code>CLICKED</code>).
+     *
+     * @param longDurationMs Default 750ms
+     */
+    void setLongClickDuration(uint16_t longDurationMs=750) { longClickMs = longDurationMs; }
+    ///@}
+
+    ///@{
+    /**
+     * @name Common Methods
+     * @details These methods are common to all InputEvent classes.
+     *
+     * Additional methods for input enable, timeout, event blocking and user ID/value are also inherited from the EventInputBase class.
+     */
+    /**
+     * @brief Initialise the EventChord and its buttons
+     *
+     * @details *Must* be called from within <code>setup()</code>
+     */
+    void begin();
+
+    /**
+     * @brief Set the Callback function.
+     *
+     * @param f A function of type <code>EventChord::CallbackFunction</code> type.
+     */
+    void setCallback(CallbackFunction f) {
+        callbackFunction = f;
+        callbackIsSet = true;
+    }
+
+    /**
+     * @brief Set the Callback function to a class method.
+     *
+     * @details Note: This method is only available if <code>std:function</code> is supported.
+     *
+     *
+     * @param instance The instance of a class implementing a CallbackFunction method.
+     * @param method The class method of type <code>EventChord::CallbackFunction</code> type.
+     */
+    #if defined(FUNCTIONAL_SUPPORTED)
+    // Method to set callback with instance and class method
+    template <typename T>
+    void setCallback(T* instance, void (T::*method)(InputEventType, EventChord&)) {
+        // Wrap the method call in a lambda
+        callbackFunction = [instance, method](InputEventType et, EventChord &ie) {
+            (instance->*method)(et, ie); // Call the member function on the instance
+        };
+        callbackIsSet = true;
+    }
+    #endif
+
+    /**
+     * @brief Unset a previously set callback function or method.
+     *
+     * @details Must be called before the set function or method is destoyed.
+     */
+    void unsetCallback() override;
+
+    /**
+     * @brief Set a handler for a single event type. It is called instead of the callback for that event.
+     *
+     * @details Events without a handler are passed to the callback (if set), so there is no need for a
+     * <code>switch</code> in the callback. If no callback is set, events without a handler are ignored.
+     * Up to INPUT_EVENTS_HANDLERS handlers can be set - the handler table is created the first time on() is called 
+     * (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     *
+     * @param et The event, eg <code>InputEventType::CLICKED</code>
+     * @param handler A function of type <code>EventChord::CallbackFunction</code> or nullptr to remove the handler
+     * @return false if the handler table is full
+     */
+    bool on(InputEventType et, CallbackFunction handler) { return setHandler(et, handler); }
+
+    /**
+     * @brief Update the buttons and fire any held events whose chord window has passed.
+     *
+     * @details *Must* be called from within <code>loop()</code>
+     */
+    void update(uint32_t nowMs) override;
+    using EventInputBase::update;
+
+    /**
+     * @brief The number of milliseconds until the next timed event of the chord or any of its buttons is due.
+     *
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs(uint32_t nowMs) override;
+    using EventInputBase::nextDeadlineMs;
+
+    ///@}
+
+    ///@{
+    /**
+     * @name Getting the State
+     */
+
+    /**
+     * @brief The index of the chord of the current (or last) chord event, or -1 during a member event.
+     */
+    int8_t chord() { return currentMember < 0 ? lastChord : -1; }
+
+    /**
+     * @brief The button of the current (or last) member event, or nullptr during a chord event.
+     */
+    EventButton* member() { return currentMember < 0 ? nullptr : memberAt(currentMember); }
+
+    /**
+     * @brief The index of the chord that is pressed, or -1 if none.
+     */
+    int8_t pressedChord() { return activeChord; }
+
+    /**
+     * @brief A mask of the member buttons that are pressed.
+     */
+    uint16_t pressedMask() { return pressedMembers; }
+
+    /**
+     * @brief Duration in milliseconds that the current (or last) chord has been (or was) pressed.
+     */
+    uint32_t chordDuration() { return (activeChord < 0 ? releasedMs : updateMs) - chordPressedMs; }
+    ///@}
+
+protected:
+    void invoke(InputEventType et) override { invokeHandler(et, callbackFunction, *this); }
+    void onEnabled() override;
+    void onDisabled() override;
+    int16_t eventPayload(InputEventType et) override;
+
+    /**
+     * Hold, suppress or pass on a member button event
+     */
+    void onInputCallback(InputEventType et, EventButton & button);
+
+private:
+    InputListener members[INPUT_EVENTS_CHORD_MEMBERS]; // The listener's input is the button (nullptr once destroyed)
+    uint16_t chords[INPUT_EVENTS_CHORDS];
+    uint8_t memberCount = 0;
+    uint8_t chordCount = 0;
+
+    uint16_t chordMembers = 0;   // Members that are part of any chord
+    uint16_t pressedMembers = 0;
+    uint16_t heldMembers = 0;    // Members with a held PRESSED event
+    uint16_t suppressedMembers = 0;
+    uint16_t autoRegisteredMembers = 0; // Members that were auto registering before they were added
+    uint16_t begunMembers = 0;
+
+    uint8_t heldOrder[INPUT_EVENTS_CHORD_MEMBERS];
+    uint32_t heldUs[INPUT_EVENTS_CHORD_MEMBERS];
+    uint8_t heldCount = 0;
+
+    int8_t activeChord = -1;
+    int8_t lastChord = -1;
+    int8_t currentMember = -1;
+
+    uint16_t chordWindowMs;
+    uint16_t longClickMs = 750;
+    uint32_t windowStartMs = 0;
+    uint32_t chordPressedMs = 0;
+    uint32_t releasedMs = 0;
+
+    int8_t indexOf(EventButton& button);
+    EventButton* memberAt(uint8_t index) { return static_cast<EventButton*>(members[index].getInput()); }
+    void matchChord(bool windowClosed);
+    void pressChord(int8_t c);
+    void releaseChord();
+    void fireHeld();
+    void fireMember(InputEventType et, int8_t index);
+
+/// \cond DO_NOT_DOCUMENT
+#ifndef FUNCTIONAL_SUPPORTED
+private:
+    static void buttonListener(InputEventType et, EventInputBase &btn) {
+        EventChord *instance = static_cast<EventChord *>(btn.getOwner());
+        if (instance) instance->onInputCallback(et, static_cast<EventButton &>(btn));
+    }
+#endif
+/// \endcond
+
+};
+
+
+#endif
@@ -25,20 +25,14 @@ EventEncoder::EventEncoder(EncoderAdapter *encoderAdapter) {
 }
 
 EventEncoder::~EventEncoder() {
-    delete encoder;
+    // The EncoderAdapter is owned by the caller - it is not deleted here
 }
 
 void EventEncoder::begin() {
     encoder->begin(); // = new Encoder(encoderPin1, encoderPin2); 
+    registerInput();
 }
 
-void EventEncoder::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
-}
-
-
 void EventEncoder::onEnabled() {
     //Reset the encoder so we don't trigger other events
     //idleFlagged = true;
@@ -52,24 +46,36 @@ void EventEncoder::unsetCallback() {
     EventInputBase::unsetCallback();
 }
 
-void EventEncoder::update() {
+void EventEncoder::update(uint32_t nowMs) {
     // @TODO Do we store the current position when disabled and update if re-enabled?
     if ( _enabled ) {
+        updateMs = nowMs;
         //encoder udate (fires encoder rotation callbacks)
-        if ( millis() > (rateLimitCounter + rateLimit) ) { 
+        if ( (InputTicks)(nowMs - rateLimitCounter) > rateLimit ) { 
             readIncrement();
             if ( encoderIncrement !=0 ) {
+                eventUs = InputClock::us();
                 currentPosition += encoderIncrement;
                 invoke(InputEventType::CHANGED);
             }
-            rateLimitCounter = millis();
+            rateLimitCounter = nowMs;
         }
-        EventInputBase::update();
+        EventInputBase::update(nowMs);
+    }
+}
+
+uint32_t EventEncoder::nextDeadlineMs(uint32_t nowMs) {
+    uint32_t next = EventInputBase::nextDeadlineMs(nowMs);
+    // Only a turn that has not been reported yet is held back by the rate limit
+    if ( _enabled && dividedPosition() != oldPosition ) {
+        uint32_t elapsed = (InputTicks)(nowMs - rateLimitCounter);
+        next = min(next, elapsed > rateLimit ? 0 : rateLimit + 1 - elapsed);
     }
+    return next;
 }
 
 void EventEncoder::readIncrement() {
-    long newPosition = floor(encoder->getPosition()/positionDivider);
+    long newPosition = dividedPosition();
     encoderIncrement = newPosition - oldPosition;
     oldPosition = newPosition;
 }
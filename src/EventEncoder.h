@@ -34,9 +34,9 @@ class EventEncoder : public EventInputBase {
 
     #if defined(FUNCTIONAL_SUPPORTED)
         /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
+         * @brief If <code>std::function</code> is supported, this creates the callback type (a heap free InputDelegate by default).
          */
-        typedef std::function<void(InputEventType et, EventEncoder &ie)> CallbackFunction;
+        typedef InputCallback<void(InputEventType et, EventEncoder &ie)> CallbackFunction;
     #else
         /**
          * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
@@ -47,13 +47,19 @@ class EventEncoder : public EventInputBase {
     /**
      * @brief The callback function member.
      */
-    CallbackFunction callbackFunction = NULL;
+    CallbackFunction callbackFunction = nullptr;
+
 
     /**
      * @brief Read and set the increment during update()
      */
     void readIncrement();
 
+    /**
+     * @brief The encoder's position in clicks (see setPositionDivider())
+     */
+    long dividedPosition() { return floor(encoder->getPosition()/positionDivider); }
+
 public:
 
     ///@{ 
@@ -73,9 +79,14 @@ public:
     EventEncoder(EncoderAdapter *encoderAdapter);
 
     /**
-     * @brief Destroy the EventEncoder input
+     * @brief Destroy the EventEncoder input. The EncoderAdapter is owned by the caller and is not deleted.
      */
     ~EventEncoder();
+
+    /// \cond DO_NOT_DOCUMENT
+    EventEncoder(const EventEncoder&) = delete; // Owns the handler table
+    EventEncoder& operator=(const EventEncoder&) = delete;
+    /// \endcond
     ///@}
 
     ///@{ 
@@ -131,12 +142,35 @@ public:
      */
     void unsetCallback() override;
 
+    /**
+     * @brief Set a handler for a single event type. It is called instead of the callback for that event.
+     * 
+     * @details Events without a handler are passed to the callback (if set), so there is no need for a 
+     * <code>switch</code> in the callback. If no callback is set, events without a handler are ignored.
+     * Up to INPUT_EVENTS_HANDLERS handlers can be set - the handler table is created the first time on() is called 
+     * (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     * 
+     * @param et The event, eg <code>InputEventType::CLICKED</code>
+     * @param handler A function of type <code>EventEncoder::CallbackFunction</code> or nullptr to remove the handler
+     * @return false if the handler table is full
+     */
+    bool on(InputEventType et, CallbackFunction handler) { return setHandler(et, handler); }
+
     /**
      * @brief Update the state from the underlying encoder library.
      * 
      * @details Must be called from within <code>loop()</code>
      */
-    void update();
+    void update(uint32_t nowMs) override;
+    using EventInputBase::update;
+
+    /**
+     * @brief The number of milliseconds until a turn held back by the rate limit or the IDLE event is due.
+     * 
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs(uint32_t nowMs) override;
+    using EventInputBase::nextDeadlineMs;
     ///@}
 
     ///@{
@@ -207,8 +241,9 @@ public:
 
 protected:
 
-    void invoke(InputEventType et) override;
+    void invoke(InputEventType et) override { invokeHandler(et, callbackFunction, *this); }
     void onEnabled() override;
+    int16_t eventPayload(InputEventType /*et*/) override { return increment(); }
 
 private:
 
@@ -218,7 +253,7 @@ private:
     int32_t currentPosition  = 0;
     int32_t oldPosition  = 0;
     unsigned int rateLimit = 0;
-    unsigned long rateLimitCounter = 0;   
+    InputTicks rateLimitCounter = 0;
     int encoderIncrement  = 0;
 
 };
@@ -28,6 +28,9 @@ EventEncoderButton::EventEncoderButton(EncoderAdapter *encoderAdapter, PinAdapte
     }
 
 void EventEncoderButton::setCallbacks() {
+    // Only the EventEncoderButton is registered, it updates the encoder and button
+    encoder.enableAutoRegister(false);
+    button.enableAutoRegister(false);
     #ifdef FUNCTIONAL_SUPPORTED
     encoder.setCallback([&](InputEventType et, EventEncoder &enc) { onInputCallback(et, enc); });
     button.setCallback([&](InputEventType et, EventButton &btn) { onInputCallback(et, btn); });
@@ -42,6 +45,7 @@ void EventEncoderButton::setCallbacks() {
 void EventEncoderButton::begin() {
     encoder.begin();
     button.begin();
+    registerInput();
 }
 
 void EventEncoderButton::unsetCallback() {
@@ -49,15 +53,21 @@ void EventEncoderButton::unsetCallback() {
     EventInputBase::unsetCallback();
 }
 
-void EventEncoderButton::update() {
-    encoder.update();
-    button.update();
+void EventEncoderButton::update(uint32_t nowMs) {
+    updateMs = nowMs;
+    encoder.update(nowMs);
+    button.update(nowMs);
 }
 
-void EventEncoderButton::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
+uint32_t EventEncoderButton::nextDeadlineMs(uint32_t nowMs) {
+    return min(encoder.nextDeadlineMs(nowMs), button.nextDeadlineMs(nowMs));
+}
+
+int16_t EventEncoderButton::eventPayload(InputEventType et) {
+    if ( et == InputEventType::CHANGED || et == InputEventType::CHANGED_PRESSED || et == InputEventType::CHANGED_RELEASED ) {
+        return increment();
+    }
+    return clickCount();
 }
 
 void EventEncoderButton::onEnabled() {
@@ -105,6 +115,7 @@ void EventEncoderButton::onInputCallback(InputEventType et, EventInputBase & ie)
     }
 
     //Translate the callback
+    eventUs = ie.eventTimestamp();
     invoke(et);    
 }
 
@@ -50,9 +50,9 @@ class EventEncoderButton : public EventInputBase {
 
     #if defined(FUNCTIONAL_SUPPORTED)
         /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
+         * @brief If <code>std::function</code> is supported, this creates the callback type (a heap free InputDelegate by default).
          */
-        typedef std::function<void(InputEventType et, EventEncoderButton &ie)> CallbackFunction;
+        typedef InputCallback<void(InputEventType et, EventEncoderButton &ie)> CallbackFunction;
     #else
         /**
          * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
@@ -65,6 +65,7 @@ class EventEncoderButton : public EventInputBase {
      */
     CallbackFunction callbackFunction = nullptr;
 
+
 public:
 
     ///@{
@@ -100,6 +101,11 @@ public:
      */
     EventEncoderButton(EncoderAdapter *encoderAdapter, PinAdapter* _pinAdapter, DebounceAdapter* debounceAdapter);
 
+    /// \cond DO_NOT_DOCUMENT
+    EventEncoderButton(const EventEncoderButton&) = delete; // Owns the handler table
+    EventEncoderButton& operator=(const EventEncoderButton&) = delete;
+    /// \endcond
+
     ///@}
 
     ///@{ 
@@ -154,12 +160,35 @@ public:
      */
     void unsetCallback() override;
 
+    /**
+     * @brief Set a handler for a single event type. It is called instead of the callback for that event.
+     * 
+     * @details Events without a handler are passed to the callback (if set), so there is no need for a 
+     * <code>switch</code> in the callback. If no callback is set, events without a handler are ignored.
+     * Up to INPUT_EVENTS_HANDLERS handlers can be set - the handler table is created the first time on() is called 
+     * (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     * 
+     * @param et The event, eg <code>InputEventType::CLICKED</code>
+     * @param handler A function of type <code>EventEncoderButton::CallbackFunction</code> or nullptr to remove the handler
+     * @return false if the handler table is full
+     */
+    bool on(InputEventType et, CallbackFunction handler) { return setHandler(et, handler); }
+
     /**
      * @brief Update the state from the underlying encoder library and button pin
      * 
      * @details *Must* be called from within <code>loop()</code>
      */
-    void update();
+    void update(uint32_t nowMs) override;
+    using EventInputBase::update;
+
+    /**
+     * @brief The number of milliseconds until the next timed event of either the encoder or button is due.
+     * 
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs(uint32_t nowMs) override;
+    using EventInputBase::nextDeadlineMs;
 
     ///@}
 
@@ -416,9 +445,10 @@ public:
     ///@}
 
 protected:
-    void invoke(InputEventType et) override;
+    void invoke(InputEventType et) override { invokeHandler(et, callbackFunction, *this); }
     void onEnabled() override;
     void onDisabled() override;
+    int16_t eventPayload(InputEventType et) override;
     void onIdle() override {/* Do nothing. Fire idle callback from either encoder or button but only if both are idle.*/ }
 
     EventEncoder encoder; ///< the EventEncoder instance
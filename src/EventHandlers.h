@@ -0,0 +1,143 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef EVENT_HANDLERS_H
+#define EVENT_HANDLERS_H
+
+#include <Arduino.h>
+
+#include "InputEvents.h"
+
+#ifndef INPUT_EVENTS_HANDLERS
+/**
+ * @brief The number of per-event handlers (see on()) each input can hold. Can be overridden with a build flag.
+ */
+#define INPUT_EVENTS_HANDLERS 6
+#endif
+
+static_assert(INPUT_EVENTS_HANDLERS > 0 && INPUT_EVENTS_HANDLERS < 255, "INPUT_EVENTS_HANDLERS must be between 1 and 254");
+
+/**
+ * @brief The part of an EventHandlers table that does not depend on the callback type: which handler slot 
+ * each InputEventType uses.
+ * 
+ * @details Inputs hold their table through this class (see EventInputBase::setHandler()). The destructor is 
+ * virtual so the table can be destroyed without knowing the callback type.
+ */
+class EventHandlerTable {
+
+    public:
+
+    virtual ~EventHandlerTable() {}
+
+    /**
+     * @brief Returns the events that have a handler.
+     */
+    InputEventMask handledEvents() { return events; }
+
+    protected:
+
+    /**
+     * @brief The 1 based slot of an event's handler, assigning a free slot if it has none.
+     * 
+     * @return 0 if the table is full
+     */
+    uint8_t assign(InputEventType et) {
+        uint8_t i = static_cast<uint8_t>(et);
+        if ( slot[i] == 0 ) {
+            slot[i] = findFreeSlot();
+            if ( slot[i] == 0 ) return 0;
+        }
+        events |= eventMask(et);
+        return slot[i];
+    }
+
+    /**
+     * @brief Free the slot of an event's handler.
+     * 
+     * @return The 1 based slot that was freed, 0 if the event had no handler
+     */
+    uint8_t unassign(InputEventType et) {
+        uint8_t i = static_cast<uint8_t>(et);
+        uint8_t s = slot[i];
+        slot[i] = 0;
+        events &= ~eventMask(et);
+        return s;
+    }
+
+    /**
+     * @brief The 1 based slot of an event's handler, 0 if it has none.
+     */
+    uint8_t slotOf(InputEventType et) { return slot[static_cast<uint8_t>(et)]; }
+
+    private:
+
+    uint8_t findFreeSlot() {
+        bool used[INPUT_EVENTS_HANDLERS] = {false};
+        for ( uint8_t i = 0; i < NUM_EVENT_TYPE_ENUMS; i++ ) {
+            if ( slot[i] ) used[slot[i] - 1] = true;
+        }
+        for ( uint8_t i = 0; i < INPUT_EVENTS_HANDLERS; i++ ) {
+            if ( !used[i] ) return i + 1;
+        }
+        return 0;
+    }
+
+    uint8_t slot[NUM_EVENT_TYPE_ENUMS] = {0}; ///< 1 based index into the handlers, 0 if no handler
+    InputEventMask events = 0;
+
+};
+
+/**
+ * @brief A compact table of handlers indexed by InputEventType, as created by the on() method of each input.
+ * 
+ * @details The table holds one byte per InputEventType (the handler's slot, or 0 for none) and 
+ * INPUT_EVENTS_HANDLERS handlers, so finding the handler for an event is a single indexed load.
+ * 
+ * @tparam CallbackT The input's CallbackFunction type
+ */
+template <typename CallbackT>
+class EventHandlers : public EventHandlerTable {
+
+    public:
+
+    /**
+     * @brief Set (or replace) the handler for an event.
+     * 
+     * @return false if the table is full
+     */
+    bool set(InputEventType et, CallbackT handler) {
+        uint8_t s = assign(et);
+        if ( s == 0 ) return false;
+        handlers[s - 1] = handler;
+        return true;
+    }
+
+    /**
+     * @brief Remove the handler for an event.
+     */
+    void clear(InputEventType et) {
+        uint8_t s = unassign(et);
+        if ( s ) handlers[s - 1] = nullptr;
+    }
+
+    /**
+     * @brief Returns the handler for an event (or nullptr if there is none).
+     */
+    CallbackT* find(InputEventType et) {
+        uint8_t s = slotOf(et);
+        return s ? &handlers[s - 1] : nullptr;
+    }
+
+    private:
+
+    CallbackT handlers[INPUT_EVENTS_HANDLERS] = {};
+
+};
+
+#endif
@@ -7,6 +7,57 @@
  */
 
 #include "EventInputBase.h"
+#include "InputRegistry.h"
+#include "EventQueue.h"
+
+// Each input class checks its size against INPUT_EVENTS_SIZE_LIMIT (compact sizes first, then default sizes)
+static_assert(sizeof(EventInputBase) <= INPUT_EVENTS_SIZE_LIMIT((15, 20, 32, 24, 40), (32, 36, 48, 40, 56)), "EventInputBase has grown (see INPUT_EVENTS_SIZE_LIMIT)");
+
+#ifdef INPUT_EVENTS_COMPACT
+uint32_t EventInputBase::updateMs = 0;
+uint32_t EventInputBase::eventUs = 0;
+#endif
+
+EventInputBase::~EventInputBase() {
+    InputRegistry::remove(this);
+    // Queued events must not point to a destroyed input
+    EventQueue* registryQueue = InputRegistry::getEventQueue();
+    if ( registryQueue ) {
+        registryQueue->forgetInput(this);
+    }
+    if ( routing ) {
+        if ( routing->eventQueue && routing->eventQueue != registryQueue ) {
+            routing->eventQueue->forgetInput(this);
+        }
+        for ( InputListener* l = routing->firstListener; l != nullptr; l = l->nextListener ) {
+            l->input = nullptr;
+        }
+        AdapterPool::destroy(routing->handlerTable);
+        AdapterPool::destroy(routing);
+    }
+}
+
+EventInputBase::Routing* EventInputBase::useRouting() {
+    if ( !routing ) {
+        routing = AdapterPool::create<Routing>();
+    }
+    return routing;
+}
+
+void EventInputBase::setEventQueue(EventQueue* queue) {
+    if ( routing || queue ) useRouting()->eventQueue = queue;
+}
+
+EventQueue* EventInputBase::getEventQueue() {
+    if ( routing && routing->eventQueue ) return routing->eventQueue;
+    return autoRegister ? InputRegistry::getEventQueue() : nullptr;
+}
+
+void EventInputBase::registerInput() {
+    if ( autoRegister ) {
+        InputRegistry::add(this);
+    }
+}
 
 void EventInputBase::unsetCallback() {
     callbackIsSet = false;
@@ -15,10 +66,12 @@ void EventInputBase::unsetCallback() {
     #endif
 }
 
-void EventInputBase::update() {
+void EventInputBase::update(uint32_t nowMs) {
+    updateMs = nowMs;
     //fire idle timeout callback
-    if ( _enabled && !idleFlagged && msSinceLastEvent() > idleTimeout) {
+    if ( _enabled && !idleFlagged && (InputTicks)(nowMs - lastEventMs) > idleTimeout) {
         idleFlagged = true;
+        eventUs = InputClock::us();
         onIdle();
     }
 }
@@ -30,22 +83,49 @@ void EventInputBase::onDisabled() { invoke(InputEventType::DISABLED); }
 void EventInputBase::onIdle() { invoke(InputEventType::IDLE); }
 
 
-void EventInputBase::resetIdleTimer() { 
-    lastEventMs = millis(); 
+void EventInputBase::resetIdleTimer(uint32_t nowMs) { 
+    lastEventMs = nowMs; 
     idleFlagged = false;
+    invalidateDeadline();
+}
+
+uint32_t EventInputBase::nextDeadlineMs(uint32_t nowMs) {
+    if ( !_enabled || idleFlagged ) return NO_DEADLINE;
+    uint32_t elapsed = (InputTicks)(nowMs - lastEventMs);
+    return elapsed > idleTimeout ? 0 : idleTimeout + 1 - elapsed; // IDLE fires when elapsed > idleTimeout
+}
+
+bool EventInputBase::isDeadlineDue(uint32_t nowMs, InputTicks deadlineAtMs) {
+    if ( !deadlineKnown ) return true;
+    if ( !deadlinePending ) return false;
+    InputTicks late = nowMs - deadlineAtMs; // Safe across millis() rollover
+    return late <= MAX_TICKS_AHEAD;
+}
+
+void EventInputBase::scheduleDeadline(uint32_t nowMs, InputTicks& deadlineAtMs) {
+    uint32_t ms = nextDeadlineMs(nowMs);
+    deadlinePending = ( ms != NO_DEADLINE );
+    if ( ms > MAX_TICKS_AHEAD ) ms = MAX_TICKS_AHEAD; // Waking early is harmless, the deadline is recalculated
+    deadlineAtMs = nowMs + ms;
+    deadlineKnown = true;
 }
 
 
 void EventInputBase::blockEvent(InputEventType et) {
     uint8_t index = static_cast<uint8_t>(et) >> 3;    // Find the index of the array (byte position)
     uint8_t position = static_cast<uint8_t>(et) & 7; // Find the position within the byte (bit position)
-    excludedEvents[index] |= (1 << position);  // Set the corresponding bit
+    useRouting()->excludedEvents[index] |= (1 << position);  // Set the corresponding bit
 }
 
 void EventInputBase::allowEvent(InputEventType et) {
+    if ( !routing ) return; // Nothing is blocked
     uint8_t index = static_cast<uint8_t>(et) >> 3;
     uint8_t position = static_cast<uint8_t>(et) & 7;
-    excludedEvents[index] &= ~(1 << position); // Clear the corresponding bit
+    routing->excludedEvents[index] &= ~(1 << position); // Clear the corresponding bit
+}
+
+void EventInputBase::allowAllEvents() {
+    if ( routing ) memset(routing->excludedEvents, 0, sizeof(routing->excludedEvents)); // Reset the bitmask to 0
 }
 
 void EventInputBase::blockAllEvents() {
@@ -55,23 +135,109 @@ void EventInputBase::blockAllEvents() {
 }
 
 bool EventInputBase::isEventAllowed(InputEventType et) {
+    if ( !routing ) return true;
     uint8_t index = static_cast<uint8_t>(et) >> 3;
     uint8_t position = static_cast<uint8_t>(et) & 7;
-    return (excludedEvents[index] & (1 << position)) == 0; // Check if the corresponding bit is set
+    return (routing->excludedEvents[index] & (1 << position)) == 0; // Check if the corresponding bit is set
 }
 
 bool EventInputBase::isInvokable(InputEventType et) {
-    if ( callbackIsSet && isEventAllowed(et) ) {
+    InputEventMask bit = eventMask(et);
+    bool listened = routing && ( routing->listenerEvents & bit ) != 0;
+    bool handled = callbackIsSet || ( routing && ( routing->handlerEvents & bit ) != 0 );
+    EventQueue* eventQueue = getEventQueue();
+    if ( handled || eventQueue || listened ) {
+        if ( !isEventAllowed(et) ) {
+            #ifdef INPUT_EVENTS_PERF
+            perf.suppressed++;
+            #endif
+            return false;
+        }
+        #ifdef INPUT_EVENTS_PERF
+        perf.fired[static_cast<uint8_t>(et)]++;
+        #endif
+        #ifdef INPUT_EVENTS_RECORDER
+        if ( FlightRecorder* recorder = InputRegistry::getRecorder() ) {
+            recorder->recordEvent(input_id, et, eventPayload(et), eventUs);
+        }
+        #endif
         if ( et > InputEventType::IDLE ) { //Check if exent is not NONE, ENABLE, DISABLED or IDLE
-            resetIdleTimer();    
+            resetIdleTimer(updateMs);    
         }
-        return true;
+        if ( listened ) {
+            CallbackScope scope(*this, false); // Latency is recorded at the callback
+            notifyListeners(et);
+        }
+        if ( eventQueue ) {
+            eventQueue->push({ this, input_id, et, updateMs, eventPayload(et), eventUs });
+            return false;
+        }
+        return handled;
+    }
+    return false;
+}
+
+bool EventInputBase::isEventHandled(InputEventType et) {
+    bool routed = routing && ( (routing->handlerEvents | routing->listenerEvents) & eventMask(et) );
+    if ( callbackIsSet || routed || getEventQueue() ) {
+        return isEventAllowed(et);
     }
     return false;
 }
 
+void EventInputBase::addListener(InputListener* listener) {
+    if ( listener == nullptr || listener->input == this ) return;
+    if ( listener->input ) {
+        listener->input->removeListener(listener);
+    }
+    listener->nextListener = nullptr;
+    listener->input = this;
+    InputListener** link = &useRouting()->firstListener;
+    while ( *link ) {
+        link = &(*link)->nextListener;
+    }
+    *link = listener;
+    routing->listenerEvents |= listener->events;
+}
+
+void EventInputBase::removeListener(InputListener* listener) {
+    if ( !routing ) return;
+    for ( InputListener** link = &routing->firstListener; *link != nullptr; link = &(*link)->nextListener ) {
+        if ( *link == listener ) {
+            *link = listener->nextListener;
+            listener->nextListener = nullptr;
+            listener->input = nullptr;
+            refreshListenerEvents();
+            return;
+        }
+    }
+}
+
+void EventInputBase::refreshListenerEvents() {
+    if ( !routing ) return;
+    routing->listenerEvents = 0;
+    for ( InputListener* l = routing->firstListener; l != nullptr; l = l->nextListener ) {
+        routing->listenerEvents |= l->events;
+    }
+}
+
+void EventInputBase::notifyListeners(InputEventType et) {
+    InputEventMask bit = eventMask(et);
+    InputListener* l = routing->firstListener;
+    while ( l ) {
+        InputListener* next = l->nextListener; // The listener may remove itself
+        if ( l->events & bit ) {
+            l->function(et, *this);
+        }
+        l = next;
+    }
+}
+
 void EventInputBase::enable(bool e ) {
     _enabled = e;
+    updateMs = InputClock::ms();
+    eventUs = InputClock::us();
+    invalidateDeadline();
     if ( e ) {
         idleFlagged = true;
         onEnabled();
@@ -12,11 +12,31 @@
 #include <Arduino.h>
 
 #include "InputEvents.h"
+#include "InputClock.h"
 
-#ifdef FUNCTIONAL_SUPPORTED
-    #include <functional>
-#endif
+#include "InputDelegate.h"
+#include "InputListener.h"
+#include "EventHandlers.h"
+#include "AdapterPool.h"
+#include "InputPerf.h"
+#include "InputLatency.h"
+
+class InputRegistry;
+class EventQueue;
+
+/**
+ * @brief The type an input template passes to its callbacks: SelfT, or the template itself if SelfT is void.
+ * 
+ * @details Lets a class derived from an input template (eg EventButton from BasicEventButton) receive 
+ * itself in its callbacks.
+ */
+template <class SelfT, class InputT>
+struct InputSelfType { typedef SelfT type; };
 
+/// \cond DO_NOT_DOCUMENT
+template <class InputT>
+struct InputSelfType<void, InputT> { typedef InputT type; };
+/// \endcond
 
 /**
  * @brief The common base for InputEvents input classes.
@@ -25,19 +45,71 @@
  */
 class EventInputBase {
 
+    friend class InputRegistry;
+
+    private:
+
+    /**
+     * @brief Where an input's events go other than its callback: its queue, listeners, per-event handlers 
+     * and blocked events.
+     * @details Most inputs only use a callback, so this is only created (in the AdapterPool if configured) 
+     * when one of them is first set, keeping each input small.
+     */
+    struct Routing {
+        EventQueue* eventQueue = nullptr; ///< Set with setEventQueue()
+        InputListener* firstListener = nullptr;
+        EventHandlerTable* handlerTable = nullptr; ///< The handlers set with setHandler()
+        InputEventMask listenerEvents = 0; ///< The union of every listener's events
+        InputEventMask handlerEvents = 0; ///< The events with a per-event handler
+        uint8_t excludedEvents[(NUM_EVENT_TYPE_ENUMS + 7) / 8] = {0};
+    };
+
+    EventInputBase* nextInput = nullptr; ///< Intrusive link for the InputRegistry
+    Routing* routing = nullptr; ///< nullptr until a queue, listener, handler or blocked event is set
 
     protected:
 
+    /// \cond DO_NOT_DOCUMENT
+    #ifndef FUNCTIONAL_SUPPORTED
+    void *owner = nullptr; // With the other pointers, so the small members below pack after it
+    #endif
+    /// \endcond
+
+    InputTicks lastEventMs = InputClock::ms(); ///< number of milliseconds since the last event
+    InputTicks idleTimeout = 10000; ///< The idle timeout in milliseconds
     uint8_t input_id = 0; ///< Input ID, not used internally
     uint8_t input_value = 0; ///< Input value, not used internally
-    bool _enabled = true; ///< Input enabled flag
-    bool idleFlagged = true; ///< True if input is idle
-    unsigned long lastEventMs = millis(); ///< number of milliseconds since the last event
-    unsigned long idleTimeout = 10000; ///< The idle timeout in milliseconds
+    bool _enabled INPUT_EVENTS_FLAG; ///< Input enabled flag
+    bool autoRegister INPUT_EVENTS_FLAG; ///< Add to the InputRegistry from begin()
+    bool idleFlagged INPUT_EVENTS_FLAG; ///< True if input is idle
+    bool deadlineKnown INPUT_EVENTS_FLAG; ///< True if the cached deadline is valid
+    bool deadlinePending INPUT_EVENTS_FLAG; ///< True if there is a deadline at the cached time
+    bool callbackIsSet INPUT_EVENTS_FLAG; ///< Required because in C/C++ callback has to be defined in derived classes... :-/
+    #ifdef INPUT_EVENTS_COMPACT
+    // Only valid during an update() or callback, so in compact mode all inputs share them
+    static uint32_t updateMs; ///< The time passed to the current update(nowMs)
+    static uint32_t eventUs; ///< The InputClock::us() when the trigger of the current event was captured
+    #else
+    uint32_t updateMs = InputClock::ms(); ///< The time passed to the current (or last) update(nowMs)
+    uint32_t eventUs = 0; ///< The InputClock::us() when the trigger of the current (or last) event was captured
+    #endif
 
 
     public:
 
+    /**
+     * @brief Initialise the flags (bit fields cannot have default member initialisers).
+     */
+    EventInputBase()
+        : _enabled(true), autoRegister(true), idleFlagged(true), 
+          deadlineKnown(false), deadlinePending(false), callbackIsSet(false) 
+        { }
+
+    /**
+     * @brief Remove the input from the InputRegistry (if registered).
+     */
+    virtual ~EventInputBase();
+
     /**@{
      * @name Common Methods
      */
@@ -58,12 +130,58 @@ class EventInputBase {
      */
     bool isCallbackSet() { return callbackIsSet; }
 
+    /**
+     * @brief Add events to an EventQueue instead of calling the callback from update().
+     * 
+     * @details Blocked events are not queued. Events of inputs owned by another input (eg the 
+     * EventButton inside an EventEncoderButton) are always passed to their owner.
+     * 
+     * @param queue The queue or nullptr to go back to calling the callback (or the InputRegistry's queue)
+     */
+    void setEventQueue(EventQueue* queue);
+
+    /**
+     * @brief Returns the EventQueue events are added to: the queue set with setEventQueue(), otherwise 
+     * InputRegistry::getEventQueue() unless enableAutoRegister(false) was called (or nullptr).
+     */
+    EventQueue* getEventQueue();
+
+    /**
+     * @brief Add a listener to receive this input's events as well as the callback.
+     * 
+     * @details Listeners are called in the order they were added. A listener that has already been added 
+     * to another input is moved to this one. See InputListener.
+     * 
+     * @param listener Must remain valid until removed (it removes itself when destroyed)
+     */
+    void addListener(InputListener* listener);
+
+    /**
+     * @brief Remove a listener added with addListener().
+     */
+    void removeListener(InputListener* listener);
+
+    /**
+     * @brief Returns true if any listeners have been added.
+     */
+    bool hasListeners() { return routing && routing->firstListener; }
+
     /**
      * @brief Update the state of the input.
      * 
-     * @details *Must* be called from within <code>loop()</code>
+     * @details *Must* be called from within <code>loop()</code> unless InputRegistry::updateAll() is used.
      */
-    void update();
+    void update() { measuredUpdate(InputClock::ms()); }
+
+    /**
+     * @brief Update the state of the input with a time already sampled from InputClock::ms().
+     * 
+     * @details Use this to update several inputs with one time sample so they all agree on 'now'.
+     * Derived classes override this method (and add <code>using EventInputBase::update;</code>).
+     * 
+     * @param nowMs The current time in milliseconds
+     */
+    virtual void update(uint32_t nowMs);
 
     /**
      * @brief Returns true if input is enabled.
@@ -80,7 +198,71 @@ class EventInputBase {
      * @param e Pass false to disable (default is true)
      */
     void enable(bool e = true);
+
+    /**
+     * @brief Choose whether begin() adds this input to the InputRegistry (true by default).
+     * @details Inputs owned by another input (eg the EventButton inside an EventEncoderButton) 
+     * have this turned off so they are only updated by their owner.
+     * 
+     * @param allow Pass false to prevent registration. Must be called before begin().
+     */
+    void enableAutoRegister(bool allow = true) { autoRegister = allow; }
+
+    /**
+     * @brief Returns true if begin() adds this input to the InputRegistry (see enableAutoRegister()).
+     */
+    bool isAutoRegisterEnabled() { return autoRegister; }
+
+    /**
+     * @brief The time (in microseconds, from InputClock::us()) that the edge or sample which caused the 
+     * current event was captured.
+     * 
+     * @details Unlike <code>millis()</code> in a callback, this does not depend on when the callback runs. 
+     * For pins with edge capture (eg InterruptPinAdapter) it is the time of the interrupt. For debounced 
+     * polled pins it is the raw edge that started the change (accurate to the debouncer's 1ms resolution). 
+     * For other pins, encoders and analog inputs it is the time the change was read in update(). Click 
+     * events are stamped with the release that completed the click. Other timed events (eg LONG_PRESS, 
+     * IDLE) are stamped when update() found them due.
+     * 
+     * Valid from within the callback (and stored with queued events). Wraps every ~71 minutes like <code>micros()</code>.
+     * In compact mode (INPUT_EVENTS_COMPACT) all inputs share one timestamp, so it is only valid in the callback.
+     */
+    uint32_t eventTimestamp() { return eventUs; }
+    ///@}
+
+    #ifdef INPUT_EVENTS_PERF
+    ///@{
+    /**
+     * @name Performance Counters
+     * @details Only available if INPUT_EVENTS_PERF is defined in your build flags.
+     */
+
+    /**
+     * @brief The counters of update() calls, events and time spent in update() and callbacks.
+     */
+    InputPerf& perfCounters() { return perf; }
+
+    /**
+     * @brief Clear the performance counters.
+     */
+    void resetPerfCounters() { perf.reset(); }
     ///@}
+    #endif
+
+    #ifdef INPUT_EVENTS_LATENCY
+    ///@{
+    /**
+     * @name Latency
+     * @details Only available if INPUT_EVENTS_LATENCY is defined in your build flags.
+     */
+
+    /**
+     * @brief The histogram of the time from each event's trigger (see eventTimestamp()) to the start of its callback.
+     * @details Events sent to an EventQueue are not included.
+     */
+    InputLatency& latencyHistogram() { return latency; }
+    ///@}
+    #endif
 
     ///@{
     /**
@@ -92,12 +274,15 @@ class EventInputBase {
      * 
      * @param timeoutMs The number of milliseconds after which the IDLE event will fire
      */
-    void setIdleTimeout(unsigned int timeoutMs=10000) { idleTimeout = timeoutMs; }
+    void setIdleTimeout(unsigned int timeoutMs=10000) { 
+        idleTimeout = timeoutMs; 
+        invalidateDeadline();
+    }
 
     /** 
      * @brief Returns the number of ms since any event was fired for this input
      */
-    unsigned long msSinceLastEvent() { return millis() - lastEventMs; }
+    unsigned long msSinceLastEvent() { return (InputTicks)(InputClock::ms() - lastEventMs); }
 
     /**
      * @brief Return true if no activity for  longer than setIdleTimeout - irrespective of whether the 
@@ -106,14 +291,47 @@ class EventInputBase {
      * @return true Idle timer has ended
      * @return false  Not idle
      */
-    bool isIdle() { return (millis() - lastEventMs) > idleTimeout; }
+    bool isIdle() { return (InputTicks)(InputClock::ms() - lastEventMs) > idleTimeout; }
 
     /**
      * @brief Reset the idle timer. The IDLE event will fire setIdleTimeout ms
      * after this is called.
      * @details This is normally done automatically every time an event is fired but can be called to further delay and idle event
      */
-    void resetIdleTimer();
+    void resetIdleTimer() { resetIdleTimer(InputClock::ms()); }
+
+    /**
+     * @brief Reset the idle timer from a time already sampled from InputClock::ms().
+     * 
+     * @param nowMs The current time in milliseconds
+     */
+    void resetIdleTimer(uint32_t nowMs);
+    ///@}
+
+    ///@{
+    /**
+     * @name Deadlines
+     * @details Inputs that have no pending timers (long press, multi-click, idle, rate limit) do not need 
+     * to re-check them on every update(). These methods report when the next timed event is due so 
+     * <code>loop()</code> can sleep or do other work until then.
+     */
+    /**
+     * @brief The number of milliseconds until the next timed event is due.
+     * 
+     * @details Returns 0 if a timed event is due now or NO_DEADLINE if nothing is pending.
+     * Changes to the input's pin(s) are not deadlines - they are detected by update().
+     * 
+     * @return uint32_t Milliseconds until the next deadline or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs() { return nextDeadlineMs(InputClock::ms()); }
+
+    /**
+     * @brief The number of milliseconds from nowMs until the next timed event is due.
+     * 
+     * @param nowMs The current time in milliseconds
+     * @return uint32_t Milliseconds until the next deadline or NO_DEADLINE
+     */
+    virtual uint32_t nextDeadlineMs(uint32_t nowMs);
     ///@}
 
     ///@{
@@ -143,7 +361,7 @@ class EventInputBase {
     /**
      * @brief Clear all blocked events.
      */
-    void allowAllEvents() { memset(excludedEvents, 0, sizeof(excludedEvents)); } // Reset the bitmask to 0 
+    void allowAllEvents();
 
     /**
      * @brief Returns true if the event is not blocked.
@@ -181,7 +399,148 @@ class EventInputBase {
 
 
 protected:
-    bool callbackIsSet = false; ///< Required because in C/C++ callback has to be defined in derived classes... :-/
+
+    /**
+     * @brief Add this input to the InputRegistry if enableAutoRegister() is true. Called from begin() in derived classes.
+     */
+    void registerInput();
+
+    /**
+     * @brief Returns true if the cached deadline has passed or is not known (eg after a setting has changed).
+     * 
+     * @param nowMs The current time in milliseconds
+     * @param deadlineAtMs The cached deadline, kept by the derived class so inputs that do not cache one do not pay for it
+     */
+    bool isDeadlineDue(uint32_t nowMs, InputTicks deadlineAtMs);
+
+    /**
+     * @brief Cache the deadline from nextDeadlineMs(). Call at the end of a full update().
+     * 
+     * @param nowMs The current time in milliseconds
+     * @param deadlineAtMs Set to the millis() of the next deadline
+     */
+    void scheduleDeadline(uint32_t nowMs, InputTicks& deadlineAtMs);
+
+    /**
+     * @brief Force the next update() to recalculate the deadline. Call whenever a timer or timing setting changes.
+     */
+    void invalidateDeadline() { deadlineKnown = false; }
+
+    /**
+     * @brief Call update(nowMs), timing it if INPUT_EVENTS_PERF is defined.
+     */
+    #ifdef INPUT_EVENTS_PERF
+    void measuredUpdate(uint32_t nowMs) {
+        uint32_t startUs = InputClock::us();
+        update(nowMs);
+        perf.addUpdate(InputClock::us() - startUs);
+    }
+    #else
+    void measuredUpdate(uint32_t nowMs) { update(nowMs); }
+    #endif
+
+    /**
+     * @brief Records the latency of the event (if INPUT_EVENTS_LATENCY is defined) and times the callbacks 
+     * called while in scope (if INPUT_EVENTS_PERF is defined). Otherwise it does nothing.
+     * @details Create one in invoke() before calling the callback.
+     */
+    class CallbackScope {
+        public:
+        CallbackScope(EventInputBase& input, bool recordLatency = true)
+        #ifdef INPUT_EVENTS_PERF
+        : input(input), startUs(InputClock::us())
+        #endif
+        {
+            #ifdef INPUT_EVENTS_LATENCY
+            if ( recordLatency ) input.recordLatency();
+            #else
+            (void)input;
+            (void)recordLatency;
+            #endif
+        }
+        #ifdef INPUT_EVENTS_PERF
+        ~CallbackScope() { input.perf.addCallback(InputClock::us() - startUs); }
+        private:
+        EventInputBase& input;
+        uint32_t startUs;
+        #endif
+    };
+
+    /**
+     * @brief Set eventTimestamp() for a change at ms that was found at a reference time (eg a captured edge).
+     * 
+     * @param ms The millis() of the change
+     * @param refMs The millis() of the reference
+     * @param refUs The micros() of the reference
+     */
+    void setEventTime(uint32_t ms, uint32_t refMs, uint32_t refUs) { eventUs = refUs - (refMs - ms) * 1000UL; }
+
+    /**
+     * @brief Set the events that have a per-event handler (see on() in derived classes). Other events 
+     * are only invoked if the callback is set.
+     */
+    void setHandledEvents(InputEventMask events) { 
+        if ( routing || events ) useRouting()->handlerEvents = events; 
+        invalidateDeadline();
+    }
+
+    /**
+     * @brief Returns true if on() has been used to set any per-event handlers.
+     */
+    bool hasEventHandlers() { return routing && routing->handlerEvents != 0; }
+
+    /**
+     * @brief Set (or with an empty handler, remove) the handler for an event. Implements on() in derived classes.
+     * 
+     * @details The handler table is created in the AdapterPool (or with <code>new</code> if the pool is 
+     * full or not configured) when the first handler is set, and destroyed with the input.
+     * 
+     * @tparam CallbackT The derived class's CallbackFunction type. Must be the same for every call.
+     * @return false if INPUT_EVENTS_HANDLERS events already have a handler
+     */
+    template <class CallbackT>
+    bool setHandler(InputEventType et, CallbackT handler) {
+        EventHandlers<CallbackT>* table = routing ? static_cast<EventHandlers<CallbackT>*>(routing->handlerTable) : nullptr;
+        if ( !handler ) {
+            if ( table ) table->clear(et);
+        } else {
+            if ( !table ) {
+                table = AdapterPool::create<EventHandlers<CallbackT>>();
+                useRouting()->handlerTable = table;
+            }
+            if ( !table->set(et, handler) ) return false;
+        }
+        setHandledEvents(table ? table->handledEvents() : 0);
+        return true;
+    }
+
+    /**
+     * @brief If the event is invokable, call its handler (see setHandler()) or the callback. Implements 
+     * invoke() in derived classes.
+     * 
+     * @param et The event
+     * @param callback The callback, called if the event has no handler
+     * @param self The input passed to the handler or callback (the derived class)
+     */
+    template <class CallbackT, class InputT>
+    void invokeHandler(InputEventType et, CallbackT& callback, InputT& self) {
+        if ( isInvokable(et) ) {
+            CallbackScope scope(*this);
+            EventHandlerTable* table = routing ? routing->handlerTable : nullptr;
+            CallbackT* handler = table ? static_cast<EventHandlers<CallbackT>*>(table)->find(et) : nullptr;
+            if ( handler ) {
+                (*handler)(et, self);
+            } else {
+                callback(et, self);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns true if the event is allowed and something will receive it (the callback, 
+     * a per-event handler, a listener or an EventQueue). Use to skip work for events nobody wants.
+     */
+    bool isEventHandled(InputEventType et);
 
     /**
      * Returns true if an event can be invoked and if so, will also
@@ -189,9 +548,18 @@ protected:
      * ENABLED, DISABLED or IDLE.
      * If you don't want to reset the idle timer, use isEventAllowed()
      * The assumption is you *will* invoke() if this returns true.
+     * If an EventQueue is set, the event is queued and false is returned.
+     * Returns true if the callback is set or the event has a per-event handler.
      */
     bool isInvokable(InputEventType et);
 
+    /**
+     * @brief The payload stored with a queued event. Can be overridden by derived classes (default 0).
+     * 
+     * @param et The event being queued
+     */
+    virtual int16_t eventPayload(InputEventType /*et*/) { return 0; }
+
     /**
      * @brief To be overriden by derived classes.
      * 
@@ -216,7 +584,40 @@ protected:
 
 
 private:
-    uint8_t excludedEvents[2] = {0};
+    friend class InputListener;
+
+    #ifdef INPUT_EVENTS_PERF
+    InputPerf perf;
+    #endif
+    #ifdef INPUT_EVENTS_LATENCY
+    InputLatency latency;
+
+    /**
+     * @brief Add the time since eventTimestamp() to this input's latency histogram and the global one. 
+     * Inputs updated by another input (eg the encoder and button of an EventEncoderButton, 
+     * see enableAutoRegister()) are left out of the global histogram so events are only counted once.
+     */
+    void recordLatency() {
+        uint32_t us = InputClock::us() - eventUs;
+        latency.record(us);
+        if ( autoRegister ) InputLatency::global.record(us);
+    }
+    #endif
+
+    /**
+     * @brief The input's Routing, created if it does not exist yet.
+     */
+    Routing* useRouting();
+
+    /**
+     * @brief Recalculate listenerEvents. Called when a listener is added, removed or its events change.
+     */
+    void refreshListenerEvents();
+
+    /**
+     * @brief Call every listener whose mask contains the event.
+     */
+    void notifyListeners(InputEventType et);
 
 
 /// \cond DO_NOT_DOCUMENT
@@ -224,9 +625,6 @@ private:
 public:
     void setOwner(void *own) { owner = own; }
     void *getOwner() { return owner; }
-
-protected:
-    void *owner = nullptr;
 #endif
 /// \endcond
 
@@ -9,18 +9,32 @@
 
 #include "EventJoystick.h"
 
+static_assert(sizeof(EventJoystick) <= INPUT_EVENTS_SIZE_LIMIT((129, 188, 288, 164, 240), (192, 252, 352, 228, 304)), "EventJoystick has grown (see INPUT_EVENTS_SIZE_LIMIT)");
+
 
 EventJoystick::EventJoystick(byte analogX, byte analogY, uint8_t adcBits /*=10*/)
     : x(analogX, adcBits), y(analogY, adcBits) {
-        #ifdef FUNCTIONAL_SUPPORTED
-        x.setCallback([&](InputEventType et, EventAnalog &enc) { onInputXCallback(et, enc); });
-        y.setCallback([&](InputEventType et, EventAnalog &enc) { onInputYCallback(et, enc); });
-        #else
-        x.setOwner(this);
-        x.setCallback(EventJoystick::analogXCallback);
-        y.setOwner(this);
-        y.setCallback(EventJoystick::analogYCallback);
-        #endif
+    initAxes();
+}
+
+EventJoystick::EventJoystick(AnalogAdapter* adapterX, AnalogAdapter* adapterY, uint8_t adcBits /*=10*/)
+    : x(adapterX, adcBits), y(adapterY, adcBits) {
+    initAxes();
+}
+
+void EventJoystick::initAxes() {
+    // Only the EventJoystick is registered, it updates both axis
+    x.enableAutoRegister(false);
+    y.enableAutoRegister(false);
+    #ifdef FUNCTIONAL_SUPPORTED
+    x.setCallback([&](InputEventType et, EventAnalog &enc) { onInputXCallback(et, enc); });
+    y.setCallback([&](InputEventType et, EventAnalog &enc) { onInputYCallback(et, enc); });
+    #else
+    x.setOwner(this);
+    x.setCallback(EventJoystick::analogXCallback);
+    y.setOwner(this);
+    y.setCallback(EventJoystick::analogYCallback);
+    #endif
 }
 
 void EventJoystick::begin() {
@@ -28,6 +42,7 @@ void EventJoystick::begin() {
     y.begin();
     setCentreBoundary(200);
     setStartValues();
+    registerInput();
 }
 
 
@@ -37,6 +52,7 @@ void EventJoystick::onInputCallback(InputEventType et, EventInputBase & ie) {
     //Only fire IDLE if both the EventAnalogs are idle
     if ( et == InputEventType::IDLE && (!x.isIdle() || !y.isIdle()  ) ) return;
     //Translate the callback
+    eventUs = ie.eventTimestamp();
     invoke(et);    
 }
 
@@ -62,12 +78,17 @@ void EventJoystick::unsetCallback() {
     EventInputBase::unsetCallback();
 }
 
-void EventJoystick::update() {
-    x.update();
-    y.update();
+void EventJoystick::update(uint32_t nowMs) {
+    updateMs = nowMs;
+    x.update(nowMs);
+    y.update(nowMs);
 }
 
 
+uint32_t EventJoystick::nextDeadlineMs(uint32_t nowMs) {
+    return min(x.nextDeadlineMs(nowMs), y.nextDeadlineMs(nowMs));
+}
+
 void EventJoystick::setStartValues() {
     x.setStartValue();
     y.setStartValue();
@@ -123,10 +144,10 @@ void EventJoystick::setRateLimit(uint16_t ms) {
 }
 
 
-void EventJoystick::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
+int16_t EventJoystick::eventPayload(InputEventType et) {
+    if ( et == InputEventType::CHANGED_X ) return x.position();
+    if ( et == InputEventType::CHANGED_Y ) return y.position();
+    return 0;
 }
 
 void EventJoystick::onEnabled() {
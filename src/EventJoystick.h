@@ -31,9 +31,9 @@ protected:
 
     #if defined(FUNCTIONAL_SUPPORTED)
         /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
+         * @brief If <code>std::function</code> is supported, this creates the callback type (a heap free InputDelegate by default).
          */
-        typedef std::function<void(InputEventType et, EventJoystick &ie)> CallbackFunction;
+        typedef InputCallback<void(InputEventType et, EventJoystick &ie)> CallbackFunction;
     #else
         /**
          * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
@@ -46,12 +46,18 @@ protected:
      */
     CallbackFunction callbackFunction = nullptr;
 
+
     /**
      * @brief Override of the <code>EventInputBase::invoke()</code> virtual method.
      * 
      * @param et Enum of type <code>InputEventType</code>
      */
-    void invoke(InputEventType et) override;
+    void invoke(InputEventType et) override { invokeHandler(et, callbackFunction, *this); }
+
+    /**
+     * @brief Override of the <code>EventInputBase::eventPayload()</code> virtual method. Returns the x or y position() for CHANGED_X or CHANGED_Y.
+     */
+    int16_t eventPayload(InputEventType et) override;
 
     void onEnabled() override;
     void onDisabled() override;
@@ -74,6 +80,20 @@ public:
      * @param adcBits ADC width in bits. Default is 10.
      */
     EventJoystick(byte analogX, byte analogY, uint8_t adcBits=10);
+
+    /**
+     * @brief Construct an EventJoystick input that reads its axes from AnalogAdapters (eg an external ADC or VirtualAnalogAdapters)
+     * 
+     * @param adapterX The X axis adapter. It is not destroyed with the EventJoystick.
+     * @param adapterY The Y axis adapter. It is not destroyed with the EventJoystick.
+     * @param adcBits The resolution (in bits) of the values returned by the adapters. Default is 10.
+     */
+    EventJoystick(AnalogAdapter* adapterX, AnalogAdapter* adapterY, uint8_t adcBits=10);
+
+    /// \cond DO_NOT_DOCUMENT
+    EventJoystick(const EventJoystick&) = delete; // Owns the handler table
+    EventJoystick& operator=(const EventJoystick&) = delete;
+    /// \endcond
     ///@}
 
 
@@ -132,12 +152,35 @@ public:
      */
     void unsetCallback() override;
 
+    /**
+     * @brief Set a handler for a single event type. It is called instead of the callback for that event.
+     * 
+     * @details Events without a handler are passed to the callback (if set), so there is no need for a 
+     * <code>switch</code> in the callback. If no callback is set, events without a handler are ignored.
+     * Up to INPUT_EVENTS_HANDLERS handlers can be set - the handler table is created the first time on() is called 
+     * (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     * 
+     * @param et The event, eg <code>InputEventType::CLICKED</code>
+     * @param handler A function of type <code>EventJoystick::CallbackFunction</code> or nullptr to remove the handler
+     * @return false if the handler table is full
+     */
+    bool on(InputEventType et, CallbackFunction handler) { return setHandler(et, handler); }
+
     /**
      * @brief Update the state from both X and Y pin inputs.
      * 
      * @details *Must* be called from within <code>loop()</code>
      */
-    void update();
+    void update(uint32_t nowMs) override;
+    using EventInputBase::update;
+
+    /**
+     * @brief The number of milliseconds until the next timed event of either axis is due.
+     * 
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs(uint32_t nowMs) override;
+    using EventInputBase::nextDeadlineMs;
     ///@}
 
     ///@{ 
@@ -296,6 +339,7 @@ protected:
 
 private:
 
+    void initAxes();
 
 #ifndef FUNCTIONAL_SUPPORTED
 private:
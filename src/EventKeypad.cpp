@@ -0,0 +1,214 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "EventKeypad.h"
+
+
+EventKeypad::EventKeypad(KeypadMatrix* keypadMatrix, const char* keymap /*=nullptr*/)
+    : matrix(keypadMatrix), keymap(keymap) {}
+
+EventKeypad::~EventKeypad() {
+    AdapterPool::destroyArray(keyStates, keyCount);
+}
+
+void EventKeypad::begin() {
+    matrix->begin();
+    rows = matrix->rows();
+    cols = matrix->cols();
+    keyCount = (uint8_t)min((uint16_t)(rows * cols), (uint16_t)INPUT_EVENTS_KEYPAD_KEYS);
+    if ( !keyStates ) keyStates = AdapterPool::createArray<KeyState>(keyCount);
+    uint32_t nowMs = InputClock::ms();
+    for ( uint8_t k = 0; k < keyCount; k++ ) {
+        keyStates[k].changedMs = nowMs;
+    }
+    // Keys held at begin() are pressed but do not fire PRESSED (as EventButton)
+    rawMask = scan();
+    pressedMask = rawMask;
+    clickPending = 0;
+    registerInput();
+}
+
+void EventKeypad::unsetCallback() {
+    callbackFunction = nullptr;
+    EventInputBase::unsetCallback();
+}
+
+KeypadMask EventKeypad::scan() {
+    uint8_t rowBits[8];
+    uint8_t rowCount = 0;
+    uint8_t colMask = (uint8_t)((1 << cols) - 1);
+    for ( uint8_t shift = 0; rowCount < rows && shift < keyCount; rowCount++, shift += cols ) {
+        rowBits[rowCount] = matrix->readRow(rowCount) & colMask;
+    }
+    KeypadMask mask = 0;
+    uint8_t shift = 0;
+    for ( uint8_t r = 0; r < rowCount; r++, shift += cols ) {
+        uint8_t bits = rowBits[r];
+        if ( ghostBlocking && isGhostRow(rowBits, rowCount, r) ) {
+            bits = (uint8_t)(rawMask >> shift) & colMask; // Keep the last scan until the row is unambiguous
+        }
+        mask |= (KeypadMask)bits << shift;
+    }
+    // Drop any keys beyond INPUT_EVENTS_KEYPAD_KEYS
+    if ( keyCount < sizeof(KeypadMask) * 8 ) mask &= ((KeypadMask)1 << keyCount) - 1;
+    return mask;
+}
+
+bool EventKeypad::isGhostRow(const uint8_t* rowBits, uint8_t rowCount, uint8_t row) {
+    for ( uint8_t r = 0; r < rowCount; r++ ) {
+        uint8_t shared = rowBits[r] & rowBits[row];
+        // Two rows with two columns in common are a rectangle: any one of its corners may be a ghost
+        if ( r != row && (shared & (shared - 1)) ) return true;
+    }
+    return false;
+}
+
+void EventKeypad::update(uint32_t nowMs) {
+    if ( !_enabled || !keyStates ) return;
+    updateMs = nowMs;
+    KeypadMask raw = scan();
+    if ( raw != rawMask ) {
+        if ( rawMask == pressedMask ) bounceStartMs = nowMs;
+        rawMask = raw;
+        rawChangedMs = nowMs;
+    }
+    if ( rawMask != pressedMask && (uint32_t)(nowMs - rawChangedMs) >= debounceMs ) {
+        KeypadMask changed = rawMask ^ pressedMask;
+        pressedMask = rawMask;
+        // Stamp with the first change that started the bounce
+        setEventTime(bounceStartMs, nowMs, InputClock::us());
+        uint32_t changedUs = eventUs;
+        uint8_t key = 0;
+        for ( KeypadMask m = changed; m; m >>= 1, key++ ) {
+            if ( m & 1 ) {
+                eventUs = changedUs;
+                onKeyChanged(key, (pressedMask >> key) & 1, nowMs);
+            }
+        }
+    }
+    // Only pressed keys and keys waiting to click have timers
+    KeypadMask active = pressedMask | clickPending;
+    if ( active ) {
+        if ( pressedMask ) resetIdleTimer(nowMs);
+        uint8_t key = 0;
+        for ( KeypadMask m = active; m; m >>= 1, key++ ) {
+            if ( m & 1 ) fireTimedEvents(key, nowMs);
+        }
+    }
+    EventInputBase::update(nowMs);
+}
+
+void EventKeypad::onKeyChanged(uint8_t key, bool pressed, uint32_t nowMs) {
+    KeyState& state = keyStates[key];
+    if ( pressed ) {
+        state.changedMs = nowMs;
+        currentClicks = state.clickCounter;
+        fireKeyEvent(InputEventType::PRESSED, key);
+    } else {
+        state.pressedMs = (InputTicks)(nowMs - state.changedMs);
+        state.changedMs = nowMs;
+        state.clickCounter++;
+        clickPending |= (KeypadMask)1 << key;
+        currentClicks = state.clickCounter;
+        fireKeyEvent(InputEventType::RELEASED, key);
+    }
+}
+
+void EventKeypad::fireTimedEvents(uint8_t key, uint32_t nowMs) {
+    KeyState& state = keyStates[key];
+    KeypadMask bit = (KeypadMask)1 << key;
+    uint32_t duration = (InputTicks)(nowMs - state.changedMs);
+    //fire long press callbacks
+    if ( pressedMask & bit ) {
+        if (duration > (uint16_t)(timings.longClickDuration + (state.longPressCounter * timings.longPressInterval ))) {
+            state.longPressCounter++;
+            if ( timings.repeatLongPress || state.longPressCounter == 1 ) {
+                eventUs = InputClock::us();
+                currentClicks = state.clickCounter;
+                fireKeyEvent(InputEventType::LONG_PRESS, key);
+            }
+        }
+        return;
+    }
+    //fire key click callbacks
+    if ( (clickPending & bit) && duration > multiClickWait() ) {
+        clickPending &= ~bit;
+        setEventTime(nowMs - duration, nowMs, InputClock::us()); // The release
+        if ( state.pressedMs > timings.longClickDuration ) {
+            state.clickCounter = 0;
+            currentClicks = 1;
+            fireKeyEvent(InputEventType::LONG_CLICKED, key);
+            state.longPressCounter = 0;
+        } else {
+            currentClicks = state.clickCounter;
+            if ( state.clickCounter == 1 ) {
+                fireKeyEvent(InputEventType::CLICKED, key);
+            } else if ( state.clickCounter == 2 ) {
+                fireKeyEvent(InputEventType::DOUBLE_CLICKED, key);
+            } else {
+                fireKeyEvent(InputEventType::MULTI_CLICKED, key);
+            }
+            state.clickCounter = 0;
+        }
+    }
+}
+
+uint16_t EventKeypad::multiClickWait() {
+    if ( hasEventHandlers()
+            && !isEventHandled(InputEventType::DOUBLE_CLICKED)
+            && !isEventHandled(InputEventType::MULTI_CLICKED) ) {
+        return 0;
+    }
+    return timings.multiClickInterval;
+}
+
+uint32_t EventKeypad::nextDeadlineMs(uint32_t nowMs) {
+    uint32_t next = EventInputBase::nextDeadlineMs(nowMs);
+    if ( !_enabled || !keyStates ) return next;
+    if ( rawMask != pressedMask ) {
+        uint32_t elapsed = nowMs - rawChangedMs;
+        next = min(next, elapsed >= debounceMs ? (uint32_t)0 : debounceMs - elapsed);
+    }
+    uint8_t key = 0;
+    for ( KeypadMask m = pressedMask | clickPending; m; m >>= 1, key++ ) {
+        if ( m & 1 ) next = min(next, keyDeadlineMs(key, nowMs));
+    }
+    return next;
+}
+
+uint32_t EventKeypad::keyDeadlineMs(uint8_t key, uint32_t nowMs) {
+    KeyState& state = keyStates[key];
+    uint32_t duration = (InputTicks)(nowMs - state.changedMs);
+    if ( (pressedMask >> key) & 1 ) {
+        // LONG_PRESS fires when the duration exceeds the threshold
+        uint16_t threshold = (uint16_t)(timings.longClickDuration + (state.longPressCounter * timings.longPressInterval ));
+        return duration > threshold ? 0 : threshold + 1 - duration;
+    }
+    // The click type is decided when the duration exceeds the multi click interval
+    uint16_t wait = multiClickWait();
+    return duration > wait ? 0 : wait + 1 - duration;
+}
+
+uint32_t EventKeypad::currentDuration() {
+    return keyStates ? (InputTicks)(InputClock::ms() - keyStates[currentKey].changedMs) : 0;
+}
+
+void EventKeypad::fireKeyEvent(InputEventType et, uint8_t key) {
+    currentKey = key;
+    invoke(et);
+}
+
+void EventKeypad::onDisabled() {
+    //Reset key state
+    clickPending = 0;
+    for ( uint8_t k = 0; k < keyCount && keyStates; k++ ) {
+        keyStates[k].clickCounter = 0;
+        keyStates[k].longPressCounter = 0;
+    }
+    invoke(InputEventType::DISABLED);
+}
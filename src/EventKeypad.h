@@ -0,0 +1,371 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+
+#ifndef EVENT_KEYPAD_H
+#define EVENT_KEYPAD_H
+
+#include "Arduino.h"
+#include "EventInputBase.h"
+#include "EventButton.h"
+#include "KeypadMatrix.h"
+#include "AdapterPool.h"
+
+#ifndef INPUT_EVENTS_KEYPAD_KEYS
+/**
+ * @brief The largest number of keys (rows x columns) an EventKeypad can scan, at most 64. Can be overridden
+ * with a build flag, eg 16 for a 4x4 keypad on an AVR (so the key masks are 16 bits).
+ */
+#define INPUT_EVENTS_KEYPAD_KEYS 64
+#endif
+
+static_assert(INPUT_EVENTS_KEYPAD_KEYS <= 64, "An EventKeypad can scan at most 64 keys");
+
+/**
+ * @brief A bit for each key of an EventKeypad (bit <code>row * cols + col</code>).
+ */
+#if INPUT_EVENTS_KEYPAD_KEYS <= 16
+typedef uint16_t KeypadMask;
+#elif INPUT_EVENTS_KEYPAD_KEYS <= 32
+typedef uint32_t KeypadMask;
+#else
+typedef uint64_t KeypadMask;
+#endif
+
+/**
+ * @brief The EventKeypad class scans a key matrix (eg a 4x4 membrane keypad) and fires EventButton events for each key.
+
+   @details Each update() reads every row of the KeypadMatrix once into a mask with a bit per key. All the keys
+   are debounced together: a change is accepted once the whole matrix has been stable for the debounce interval
+   (default 10ms). Only keys that have changed, are pressed or are waiting to fire a click run the click and long
+   press timers, so an idle keypad costs little more than the scan.
+
+   Each key fires the same events, with the same timings, as an EventButton. key(), row(), col() and keyChar()
+   return the key of the current event. With an EventQueue, the event payload is the key.
+
+The following InputEventTypes are fired by EventKeypad:
+  - InputEventType::ENABLED - fired when the input is enabled.
+  - InputEventType::DISABLED - fired when the input is disabled.
+  - InputEventType::IDLE - fired after no other event (except <code>ENABLED</code> & <code>DISABLED</code>) has been fired for a specified time. Each input can define its own idle timeout. Default is 10 seconds.
+  - InputEventType::PRESSED - fired after (as) a key is pressed
+  - InputEventType::RELEASED - fired after a key is released.
+  - InputEventType::CLICKED - fired after <code>RELEASED</code> if not <code>LONG_CLICKED</code> and the key is pressed and released once.
+  - InputEventType::DOUBLE_CLICKED - fired after <code>RELEASED</code> if not <code>LONG_CLICKED</code> and the key is pressed and released twice.
+  - InputEventType::MULTI_CLICKED - fired after <code>RELEASED</code> if not <code>LONG_CLICKED</code> and the key is pressed and released more than twice. The method clickCount() returns the number of clicks.
+  - InputEventType::LONG_PRESS - fired *during* a long press (hence change of tense). Will repeat by default but this can be turned off.
+  - InputEventType::LONG_CLICKED - fired *after* a long press.
+ *
+ */
+class EventKeypad : public EventInputBase {
+
+protected:
+
+    #if defined(FUNCTIONAL_SUPPORTED)
+        /**
+         * @brief If <code>std::function</code> is supported, this creates the callback type (a heap free InputDelegate by default).
+         */
+        typedef InputCallback<void(InputEventType et, EventKeypad &ie)> CallbackFunction;
+    #else
+        /**
+         * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
+         */
+        typedef void (*CallbackFunction)(InputEventType et, EventKeypad &);
+    #endif
+
+    /**
+     * @brief The callback function member.
+     */
+    CallbackFunction callbackFunction = nullptr;
+
+
+public:
+
+    ///@{
+    /**
+     * @name Constructors
+     */
+    /**
+     * @brief Construct an EventKeypad from a KeypadMatrix (eg a GpioKeypadMatrix).
+     *
+     * @param keypadMatrix The matrix (must remain valid for the life of the keypad)
+     * @param keymap Optional characters for keyChar(), one per key in row order, eg <code>"123A456B789C*0#D"</code>
+     */
+    EventKeypad(KeypadMatrix* keypadMatrix, const char* keymap = nullptr);
+
+    /**
+     * @brief Destroy the EventKeypad and its key states.
+     * @details The key states are created by begin() (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     */
+    ~EventKeypad();
+
+    /// \cond DO_NOT_DOCUMENT
+    EventKeypad(const EventKeypad&) = delete; // Owns the key states
+    EventKeypad& operator=(const EventKeypad&) = delete;
+    /// \endcond
+
+    ///@}
+
+    ///@{
+    /**
+     * @name Common Methods
+     * @details These methods are common to all InputEvent classes.
+     *
+     * Additional methods for input enable, timeout, event blocking and user ID/value are also inherited from the EventInputBase class.
+     */
+    /**
+     * @brief Initialise the EventKeypad and its matrix.
+     *
+     * @details *Must* be called from within <code>setup()</code>
+     */
+    void begin();
+
+    /**
+     * @brief Set the Callback function.
+     *
+     * @param f A function of type <code>EventKeypad::CallbackFunction</code> type.
+     */
+    void setCallback(CallbackFunction f) {
+        callbackFunction = f;
+        callbackIsSet = true;
+    }
+
+    /**
+     * @brief Set the Callback function to a class method.
+     *
+     * @details Note: This method is only available if <code>std:function</code> is supported.
+     *
+     *
+     * @param instance The instance of a class implementing a CallbackFunction method.
+     * @param method The class method of type <code>EventKeypad::CallbackFunction</code> type.
+     */
+    #if defined(FUNCTIONAL_SUPPORTED)
+    // Method to set callback with instance and class method
+    template <typename T>
+    void setCallback(T* instance, void (T::*method)(InputEventType, EventKeypad&)) {
+        // Wrap the method call in a lambda
+        callbackFunction = [instance, method](InputEventType et, EventKeypad &ie) {
+            (instance->*method)(et, ie); // Call the member function on the instance
+        };
+        callbackIsSet = true;
+    }
+    #endif
+
+    /**
+     * @brief Unset a previously set callback function or method.
+     *
+     * @details Must be called before the set function or method is destoyed.
+     */
+    void unsetCallback() override;
+
+    /**
+     * @brief Set a handler for a single event type. It is called instead of the callback for that event.
+     *
+     * @details Events without a handler are passed to the callback (if set), so there is no need for a
+     * <code>switch</code> in the callback. If no callback is set, events without a handler are ignored.
+     * Up to INPUT_EVENTS_HANDLERS handlers can be set - the handler table is created the first time on() is called 
+     * (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     *
+     * @param et The event, eg <code>InputEventType::CLICKED</code>
+     * @param handler A function of type <code>EventKeypad::CallbackFunction</code> or nullptr to remove the handler
+     * @return false if the handler table is full
+     */
+    bool on(InputEventType et, CallbackFunction handler) { return setHandler(et, handler); }
+
+    /**
+     * @brief Scan the matrix and fire the events of any keys that have changed or have a timer due.
+     *
+     * @details *Must* be called from within <code>loop()</code>
+     */
+    void update(uint32_t nowMs) override;
+    using EventInputBase::update;
+
+    /**
+     * @brief The number of milliseconds until the next debounce, click or long press of any key is due.
+     * @details New key presses are only seen when the matrix is scanned, so update() must still be called from loop().
+     *
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs(uint32_t nowMs) override;
+    using EventInputBase::nextDeadlineMs;
+
+    ///@}
+
+    ///@{
+    /**
+     * @name Getting the State
+     * @details These methods return the key of the current (or last) event and the state of the keys.
+     */
+
+    /**
+     * @brief The key of the current (or last) event: <code>row() * cols + col()</code>.
+     */
+    uint8_t key() { return currentKey; }
+
+    /**
+     * @brief The row of the current (or last) event.
+     */
+    uint8_t row() { return cols ? currentKey / cols : 0; }
+
+    /**
+     * @brief The column of the current (or last) event.
+     */
+    uint8_t col() { return cols ? currentKey % cols : 0; }
+
+    /**
+     * @brief The character of the current (or last) event from the keymap, or 0 if no keymap is set.
+     */
+    char keyChar() { return keymap ? keymap[currentKey] : 0; }
+
+    /**
+     * @brief The number of clicks of the current (or last) event.
+     * @details Set for <code>CLICKED</code>, <code>DOUBLE_CLICKED</code> and <code>MULTI_CLICKED</code> (and 1 for <code>LONG_CLICKED</code>).
+     *
+     * @return uint8_t Number of clicks
+     */
+    uint8_t clickCount() { return currentClicks; }
+
+    /**
+     * @brief The number of times the long press has occurred during the current (or last) key press.
+     */
+    uint16_t longPressCount() { return keyStates ? keyStates[currentKey].longPressCounter : 0; }
+
+    /**
+     * @brief Returns true if a key is pressed (debounced).
+     *
+     * @param key The key (<code>row * cols + col</code>)
+     */
+    bool isPressed(uint8_t key) { return key < keyCount && (pressedMask >> key) & 1; }
+
+    /**
+     * @brief Returns true if a key is pressed (debounced).
+     */
+    bool isPressed(uint8_t row, uint8_t col) { return row < rows && col < cols && isPressed(row * cols + col); }
+
+    /**
+     * @brief A mask of the pressed keys (bit <code>row * cols + col</code>).
+     */
+    KeypadMask pressedKeys() { return pressedMask; }
+
+    /**
+     * @brief The number of keys (rows x columns, limited to INPUT_EVENTS_KEYPAD_KEYS). Set by begin().
+     */
+    uint8_t numKeys() { return keyCount; }
+
+    /**
+     * @brief Duration in milliseconds of the current state of the key of the current (or last) event.
+     */
+    uint32_t currentDuration();
+
+    ///@}
+
+    ///@{
+    /**
+     * @name Setting Timeouts & Intervals
+     * @details These apply to every key.
+     */
+
+    /**
+     * @brief Set the characters returned by keyChar(), one per key in row order.
+     */
+    void setKeymap(const char* map) { keymap = map; }
+
+    /**
+     * @brief Set the debounce interval. All keys are debounced together.
+     *
+     * @param intervalMs Default is 10ms
+     */
+    void setDebounceInterval(uint16_t intervalMs=10) { debounceMs = intervalMs; }
+
+    /**
+     * @brief Set the multi click interval.
+     *
+     * @param intervalMs The interval in milliseconds between double, triple or multi clicks
+     */
+    void setMultiClickInterval(uint16_t intervalMs=250) { timings.multiClickInterval = intervalMs; }
+
+    /**
+     * @brief Set the number of milliseconds that define the *first* long click duration.
+     *
+     * @param longDurationMs Default 750ms
+     */
+    void setLongClickDuration(uint16_t longDurationMs=750) { timings.longClickDuration = longDurationMs; }
+
+    /**
+     * @brief Set the number of milliseconds that define the *subsequent* long click intervals.
+     *
+     * @param intervalMs The interval in milliseconds (default is 500ms).
+     */
+    void setLongPressInterval(uint16_t intervalMs=500) { timings.longPressInterval = intervalMs; }
+
+    /**
+     * @brief Choose whether to repeat the long press callback. (true by default)
+     *
+     * @param repeat Pass true to repeat, false to not repeat.
+     */
+    void enableLongPressRepeat(bool repeat=true) { timings.repeatLongPress = repeat; }
+
+    /**
+     * @brief Ignore the changes of keys that may be ghosts (false by default).
+     * @details On a matrix without diodes, pressing three keys at the corners of a rectangle makes the fourth 
+     * corner read as pressed too. When enabled, rows that have two or more pressed columns in common with 
+     * another row keep their last state while they do, so a ghost key never fires (but nor does any other change
+     * to those rows until the rectangle is broken). Not needed if the keys have diodes.
+     *
+     * @param block Pass true to ignore possible ghost keys.
+     */
+    void enableGhostBlocking(bool block=true) { ghostBlocking = block; }
+    ///@}
+
+protected:
+    void invoke(InputEventType et) override { invokeHandler(et, callbackFunction, *this); }
+    void onDisabled() override;
+    int16_t eventPayload(InputEventType /*et*/) override { return currentKey; }
+
+private:
+
+    /**
+     * The click and long press state of one key
+     */
+    struct KeyState {
+        InputTicks changedMs = 0;    // When the key was last pressed or released
+        InputTicks pressedMs = 0;    // Duration of the last press
+        uint16_t longPressCounter = 0;
+        uint8_t clickCounter = 0;
+    };
+
+    KeypadMatrix* matrix;
+    const char* keymap;
+    KeyState* keyStates = nullptr;
+    ButtonTimings timings;
+
+    KeypadMask rawMask = 0;       // The last scan
+    KeypadMask pressedMask = 0;   // Debounced
+    KeypadMask clickPending = 0;  // Released keys that have not fired their click
+    uint32_t rawChangedMs = 0;    // The last change of the scan
+    uint32_t bounceStartMs = 0;   // The first change since the scan was stable
+
+    uint16_t debounceMs = 10;
+    uint8_t rows = 0;
+    uint8_t cols = 0;
+    uint8_t keyCount = 0;
+    uint8_t currentKey = 0;
+    uint8_t currentClicks = 0;
+    bool ghostBlocking = false;
+
+    KeypadMask scan();
+    bool isGhostRow(const uint8_t* rowBits, uint8_t rowCount, uint8_t row);
+    void onKeyChanged(uint8_t key, bool pressed, uint32_t nowMs);
+    void fireTimedEvents(uint8_t key, uint32_t nowMs);
+    uint32_t keyDeadlineMs(uint8_t key, uint32_t nowMs);
+    uint16_t multiClickWait();
+    void fireKeyEvent(InputEventType et, uint8_t key);
+
+};
+
+
+#endif
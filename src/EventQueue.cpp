@@ -0,0 +1,46 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "EventQueue.h"
+
+static_assert(INPUT_EVENTS_QUEUE_SIZE > 0 && INPUT_EVENTS_QUEUE_SIZE <= 255, "INPUT_EVENTS_QUEUE_SIZE must be 1 to 255");
+
+bool EventQueue::push(const InputEvent& e) {
+    if ( count == INPUT_EVENTS_QUEUE_SIZE ) {
+        if ( dropped < 0xFFFF ) dropped++;
+        return false;
+    }
+    uint16_t last = first + count;
+    if ( last >= INPUT_EVENTS_QUEUE_SIZE ) last -= INPUT_EVENTS_QUEUE_SIZE;
+    events[last] = e;
+    count++;
+    return true;
+}
+
+bool EventQueue::poll(InputEvent& e) {
+    if ( count == 0 ) return false;
+    e = events[first];
+    first++;
+    if ( first == INPUT_EVENTS_QUEUE_SIZE ) first = 0;
+    count--;
+    return true;
+}
+
+void EventQueue::forgetInput(EventInputBase* input) {
+    uint8_t i = first;
+    for ( uint8_t n = 0; n < count; n++ ) {
+        if ( events[i].input == input ) events[i].input = nullptr;
+        if ( ++i == INPUT_EVENTS_QUEUE_SIZE ) i = 0;
+    }
+}
+
+void EventQueue::dispatch() {
+    if ( count == 0 || !batchCallback ) return;
+    batchCallback(*this);
+    clear();
+}
@@ -0,0 +1,160 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <Arduino.h>
+
+#include "InputEvents.h"
+
+#include "InputDelegate.h"
+
+#ifndef INPUT_EVENTS_QUEUE_SIZE
+/**
+ * @brief The number of events an EventQueue can hold. Can be overridden with a build flag.
+ */
+#define INPUT_EVENTS_QUEUE_SIZE 16
+#endif
+
+class EventInputBase;
+
+/**
+ * @brief A compact record of an event, as held by an EventQueue.
+ */
+struct InputEvent {
+    EventInputBase* input;  ///< The input that fired the event (nullptr if the input has since been destroyed)
+    uint8_t inputId;        ///< The input's ID when the event was fired (see EventInputBase::setInputId())
+    InputEventType type;    ///< The event
+    uint32_t ms;            ///< The millis() when the event was fired
+    int16_t payload;        ///< Event data, eg clickCount() for clicks, increment() for encoders or position() for analog inputs
+    uint32_t us;            ///< The capture time of the edge or sample that caused the event (see EventInputBase::eventTimestamp())
+};
+
+/**
+ * @brief A bounded queue of InputEvents.
+ * 
+ * @details When an input has an EventQueue (see EventInputBase::setEventQueue() or InputRegistry::setEventQueue()), 
+ * its events are added to the queue instead of calling its callback from inside update(). The events can then 
+ * either be read with poll() or handed to a single batch callback with dispatch(), so a slow handler does not 
+ * delay the scanning of other inputs.
+ * 
+ * If the queue is full, new events are dropped and counted.
+ * 
+ * ```cpp
+ * EventQueue queue;
+ * 
+ * void setup() {
+ *     InputRegistry::setEventQueue(&queue);
+ *     myButton.begin();
+ * }
+ * 
+ * void loop() {
+ *     InputRegistry::updateAll();
+ *     InputEvent e;
+ *     while ( queue.poll(e) ) {
+ *         // Handle e.type from e.input
+ *     }
+ * }
+ * ```
+ */
+class EventQueue {
+
+    public:
+
+    #if defined(FUNCTIONAL_SUPPORTED)
+        /**
+         * @brief If <code>std::function</code> is supported, this creates the batch callback type (a heap free InputDelegate by default).
+         */
+        typedef InputCallback<void(EventQueue &queue)> BatchCallbackFunction;
+    #else
+        /**
+         * @brief Used to create the batch callback type as pointer if <code>std::function</code> is not supported.
+         */
+        typedef void (*BatchCallbackFunction)(EventQueue &queue);
+    #endif
+
+    /**
+     * @brief Add an event to the queue. Called by inputs, not normally needed in user code.
+     * 
+     * @return true If the event was added
+     * @return false If the queue was full (the event is dropped)
+     */
+    bool push(const InputEvent& e);
+
+    /**
+     * @brief Remove the oldest event from the queue.
+     * 
+     * @param e Set to the oldest event
+     * @return true If there was an event
+     * @return false If the queue was empty (e is unchanged)
+     */
+    bool poll(InputEvent& e);
+
+    /**
+     * @brief Returns true if there are no events in the queue.
+     */
+    bool isEmpty() { return count == 0; }
+
+    /**
+     * @brief The number of events waiting in the queue.
+     */
+    uint8_t size() { return count; }
+
+    /**
+     * @brief Remove all events from the queue.
+     */
+    void clear() { first = 0; count = 0; }
+
+    /**
+     * @brief Set the <code>input</code> of an input's queued events to nullptr. Called when an input 
+     * is destroyed, not normally needed in user code.
+     * 
+     * @details The events stay queued, with the input ID they were fired with.
+     * 
+     * @param input The input
+     */
+    void forgetInput(EventInputBase* input);
+
+    /**
+     * @brief The number of events dropped because the queue was full.
+     */
+    uint16_t droppedCount() { return dropped; }
+
+    /**
+     * @brief Set a callback that receives all queued events in one call from dispatch().
+     * 
+     * @param f A function of type <code>EventQueue::BatchCallbackFunction</code>. Read the events with poll().
+     */
+    void setBatchCallback(BatchCallbackFunction f) { batchCallback = f; }
+
+    /**
+     * @brief Unset the batch callback.
+     */
+    void unsetBatchCallback() { batchCallback = nullptr; }
+
+    /**
+     * @brief If there are queued events and a batch callback is set, call it once. Any events 
+     * not read by the callback are then cleared.
+     * 
+     * @details Called by InputRegistry::updateAll() for the registry's queue. If you are not using
+     * the registry, call this from <code>loop()</code> after updating your inputs.
+     */
+    void dispatch();
+
+    private:
+
+    InputEvent events[INPUT_EVENTS_QUEUE_SIZE];
+    uint8_t first = 0;
+    uint8_t count = 0;
+    uint16_t dropped = 0;
+    BatchCallbackFunction batchCallback = nullptr;
+
+};
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "Arduino.h"
 #include "EventInputBase.h"
+#include "AdapterPool.h"
 #include "PinAdapter/FoltmanDebounceAdapter.h"
 #include "PinAdapter/GpioPinAdapter.h"
 
@@ -29,21 +30,54 @@ The following InputEventTypes are fired by EventSwitch:
   - InputEventType::ON - fired after switch is turned on.
   - InputEventType::OFF - fired after switch is turned off.
  * 
+ * EventSwitch derives from BasicEventSwitch<PinAdapter, DebounceAdapter> and works with any adapters via virtual calls. 
+ * If the adapter types are known at compile time, pass them as the template arguments (eg GpioEventSwitch) 
+ * so reading and debouncing the pin can be inlined into update().
+ * 
+ * @tparam PinT The PinAdapter type
+ * @tparam DebounceT The DebounceAdapter type. Concrete types must implement debounce(pinState, ms).
+ * @tparam SelfT The class passed to callbacks, for classes derived from this one (eg EventSwitch). Defaults to BasicEventSwitch.
  */
-class EventSwitch : public EventInputBase {
+template <class PinT, class DebounceT, class SelfT = void>
+class BasicEventSwitch : public EventInputBase {
+
+private:
+
+    // Declared before the callback and adapters so the flags and times fill the padding at the end of EventInputBase
+    bool ownsPinAdapter INPUT_EVENTS_FLAG; //pinAdapter was created by the constructor
+    bool ownsDebouncer INPUT_EVENTS_FLAG; //debouncer was created by the constructor
+    bool onState INPUT_EVENTS_FLAG; //The state that represents 'pressed'
+
+    bool currentState INPUT_EVENTS_FLAG; //set via PinAdapter->read()
+    bool previousState INPUT_EVENTS_FLAG;
+
+    bool currentPinState INPUT_EVENTS_FLAG;
+    bool previousPinState INPUT_EVENTS_FLAG;
+
+    bool stateChanged INPUT_EVENTS_FLAG;
+    bool edgeCapture INPUT_EVENTS_FLAG; //PinAdapter captures edges
+    bool edgeState INPUT_EVENTS_FLAG; //State of the last captured edge
+    InputTicks stateChangeLastTime = 0;
+    InputTicks durationOfPreviousState = 0;
+
 
 protected:
 
+    /**
+     * @brief The class passed to callbacks (see SelfT).
+     */
+    typedef typename InputSelfType<SelfT, BasicEventSwitch>::type Self;
+
     #if defined(FUNCTIONAL_SUPPORTED)
         /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
+         * @brief If <code>std::function</code> is supported, this creates the callback type (a heap free InputDelegate by default).
          */
-        typedef std::function<void(InputEventType et, EventSwitch &ie)> CallbackFunction;
+        typedef InputCallback<void(InputEventType et, Self &ie)> CallbackFunction;
     #else
         /**
          * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
          */
-        typedef void (*CallbackFunction)(InputEventType et, EventSwitch &);
+        typedef void (*CallbackFunction)(InputEventType et, Self &);
     #endif
 
     /**
@@ -51,12 +85,13 @@ protected:
      */
     CallbackFunction callbackFunction = nullptr;
 
+
     /**
      * @brief Override of the <code>EventInputBase::invoke()</code> virtual method.
      * 
      * @param et Enum of type <code>InputEventType</code>
      */
-    void invoke(InputEventType et) override;
+    void invoke(InputEventType et) override { invokeHandler(et, callbackFunction, static_cast<Self&>(*this)); }
 
 public:
 
@@ -69,14 +104,14 @@ public:
      * 
      * @param switchPin A pin that connects to GNG via the switch
      */
-    EventSwitch(byte switchPin, bool useDefaultDebouncer=true);
+    BasicEventSwitch(byte switchPin, bool useDefaultDebouncer=true);
 
     /**
      * @brief Construct a new EventSwitch with a PinAdapter and optionally use the default debouncer
      * 
      * @param pinAdapter 
      */
-    EventSwitch(PinAdapter* _pinAdapter, bool useDefaultDebouncer=true);
+    BasicEventSwitch(PinT* _pinAdapter, bool useDefaultDebouncer=true);
 
     /**
      * @brief Construct a new EventSwitch with a PinAdapter and a DebounceAdapter
@@ -84,7 +119,17 @@ public:
      * @param pinAdapter 
      * @param debounceAdapter 
      */
-    EventSwitch(PinAdapter* _pinAdapter, DebounceAdapter* debounceAdapter);
+    BasicEventSwitch(PinT* _pinAdapter, DebounceT* debounceAdapter);
+
+    /**
+     * @brief Destroy the EventSwitch and any adapters it created (adapters you passed in are not destroyed).
+     */
+    ~BasicEventSwitch();
+
+    /// \cond DO_NOT_DOCUMENT
+    BasicEventSwitch(const BasicEventSwitch&) = delete; // Owned adapters cannot be shared
+    BasicEventSwitch& operator=(const BasicEventSwitch&) = delete;
+    /// \endcond
 
 
     ///@}
@@ -126,9 +171,9 @@ public:
     #if defined(FUNCTIONAL_SUPPORTED)
     // Method to set callback with instance and class method
     template <typename T>
-    void setCallback(T* instance, void (T::*method)(InputEventType, EventSwitch&)) {
+    void setCallback(T* instance, void (T::*method)(InputEventType, Self&)) {
         // Wrap the method call in a lambda
-        callbackFunction = [instance, method](InputEventType et, EventSwitch &ie) {
+        callbackFunction = [instance, method](InputEventType et, Self& ie) {
             (instance->*method)(et, ie); // Call the member function on the instance
         };
         callbackIsSet = true;
@@ -142,12 +187,35 @@ public:
      */
     void unsetCallback() override;
 
+    /**
+     * @brief Set a handler for a single event type. It is called instead of the callback for that event.
+     * 
+     * @details Events without a handler are passed to the callback (if set), so there is no need for a 
+     * <code>switch</code> in the callback. If no callback is set, events without a handler are ignored.
+     * Up to INPUT_EVENTS_HANDLERS handlers can be set - the handler table is created the first time on() is called 
+     * (in the AdapterPool if INPUT_EVENTS_ADAPTER_POOL_SIZE is set).
+     * 
+     * @param et The event, eg <code>InputEventType::CLICKED</code>
+     * @param handler A function of type <code>EventSwitch::CallbackFunction</code> or nullptr to remove the handler
+     * @return false if the handler table is full
+     */
+    bool on(InputEventType et, CallbackFunction handler) { return setHandler(et, handler); }
+
     /**
      * @brief Update the state from the switch pin input.
      * 
      * @details *Must* be called from within <code>loop()</code>
      */
-    void update();
+    void update(uint32_t nowMs) override;
+    using EventInputBase::update;
+
+    /**
+     * @brief The number of milliseconds until the IDLE event is due or a pending debounce completes.
+     * 
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    uint32_t nextDeadlineMs(uint32_t nowMs) override;
+    using EventInputBase::nextDeadlineMs;
     ///@}
 
     ///@{
@@ -190,11 +258,11 @@ public:
      */
     /**
      * @brief Set the debouncer.
-     * **Note:** When planning to use `setDebouncer()` you must ensure `useDefaultDebouncer` is set to `false` in the button or switch constructor. *Previously set debouncers are not deleted*.
+     * **Note:** A debouncer created by the EventSwitch (ie the default debouncer) is destroyed. Debouncers you have set are not deleted.
      * 
      * @param debounceAdapter 
      */
-    void setDebouncer(DebounceAdapter* debounceAdapter);
+    void setDebouncer(DebounceT* debounceAdapter);
 
     /**
      * @brief Set the DebounceAdapter debounce interval. Default is 10ms
@@ -220,10 +288,11 @@ public:
     /**
      * @brief Returns true if pinAdapter changed the switch state
      * 
+     * @param nowMs The time of this update()
      * @return true 
      * @return false 
      */
-    bool changedState();
+    bool changedState(uint32_t nowMs);
 
     /**
      * @brief Returns true if pinAdapter read() has changed since last call
@@ -233,12 +302,57 @@ public:
      */
     bool changedPinState();
 
+    /**
+     * @brief Read the pin via a PinAdapter (virtual).
+     */
+    bool readPin(PinAdapter* p) { return p->read(); }
+
+    /**
+     * @brief Read the pin with a concrete adapter type. The call is qualified so it is not virtual and can be 
+     * inlined (overrides in classes derived from PinT are not called).
+     */
+    template <class P>
+    bool readPin(P* p) { return p->P::read(); }
+
+    /**
+     * @brief Read the debounced pin state via a DebounceAdapter (virtual, the debouncer reads the pin).
+     */
+    bool readDebounced(DebounceAdapter* d, uint32_t nowMs) { return d->read(nowMs); }
+
+    /**
+     * @brief Read the debounced pin state with concrete adapter types so both calls can be inlined.
+     */
+    template <class D>
+    bool readDebounced(D* d, uint32_t nowMs) { return d->D::debounce(readPin(pinAdapter), nowMs); }
+
     /**
      * @brief Change the switch state and flag as changed
      * 
      * @param newState 
+     * @param ms The millis() of the change
+     */
+    void changeState(bool newState, uint32_t ms);
+
+    /**
+     * @brief Fire the ON or OFF event after a change of state
+     */
+    void onStateChanged();
+
+    /**
+     * @brief Process the edges captured by the PinAdapter (if capturesEdges() is true)
+     * 
+     * @param nowMs The time of this update()
      */
-    void changeState(bool newState);
+    void processEdges(uint32_t nowMs);
+
+    /**
+     * @brief Debounce (if a debouncer is set) a pin state at a known time and change state if required
+     * 
+     * @param pinState The (raw) pin state
+     * @param ms The millis() when the pin was in this state
+     * @param held The captured edge the state started at, to time the change from (nullptr if there is none)
+     */
+    void applyPinState(bool pinState, uint32_t ms, const PinEdge* held);
 
     /**
      * @brief Returns true if state has changed and previous state is onState
@@ -259,23 +373,228 @@ public:
 
 private:
 
-    PinAdapter* pinAdapter;
-    DebounceAdapter* debouncer;
+    /**
+     * @brief All constructors delegate to this one to initialise the flags (bit fields cannot have default member initialisers).
+     */
+    BasicEventSwitch(PinT* _pinAdapter, DebounceT* debounceAdapter, bool ownsPin, bool ownsDebounce);
 
-    bool onState = LOW; //The state that represents 'pressed'
+    PinT* pinAdapter;
+    DebounceT* debouncer = nullptr;
 
-    unsigned char currentState = HIGH;
-    bool previousState = HIGH;
+    
 
-    bool currentPinState = HIGH;
-    bool previousPinState = HIGH;
 
-    bool stateChanged = false;
-    uint32_t stateChangeLastTime;
-    uint32_t durationOfPreviousState;
+};
+
+
+template <class PinT, class DebounceT, class SelfT>
+BasicEventSwitch<PinT, DebounceT, SelfT>::BasicEventSwitch(byte pin, bool useDefaultDebouncer /*=true*/)
+    : BasicEventSwitch(AdapterPool::create<GpioPinAdapter>(pin), nullptr, true, false)
+    { 
+        if ( useDefaultDebouncer ) {
+            debouncer = AdapterPool::create<FoltmanDebounceAdapter>(pinAdapter);
+            ownsDebouncer = true;
+        }
+    }
+
+template <class PinT, class DebounceT, class SelfT>
+BasicEventSwitch<PinT, DebounceT, SelfT>::BasicEventSwitch(PinT* _pinAdapter, bool useDefaultDebouncer /*=true*/)
+    : BasicEventSwitch(_pinAdapter, nullptr, false, false)
+    { 
+        if ( useDefaultDebouncer ) {
+            debouncer = AdapterPool::create<FoltmanDebounceAdapter>(pinAdapter);
+            ownsDebouncer = true;
+        }
+    }
+
+template <class PinT, class DebounceT, class SelfT>
+BasicEventSwitch<PinT, DebounceT, SelfT>::BasicEventSwitch(PinT* _pinAdapter, DebounceT* debounceAdapter) 
+    : BasicEventSwitch(_pinAdapter, debounceAdapter, false, false)
+    { 
+        debouncer->setPinAdapter(pinAdapter);
+    }
+
+template <class PinT, class DebounceT, class SelfT>
+BasicEventSwitch<PinT, DebounceT, SelfT>::BasicEventSwitch(PinT* _pinAdapter, DebounceT* debounceAdapter, bool ownsPin, bool ownsDebounce) 
+    : ownsPinAdapter(ownsPin),
+      ownsDebouncer(ownsDebounce),
+      onState(LOW),
+      currentState(HIGH),
+      previousState(HIGH),
+      currentPinState(HIGH),
+      previousPinState(HIGH),
+      stateChanged(false),
+      edgeCapture(false),
+      edgeState(HIGH),
+      pinAdapter(_pinAdapter),
+      debouncer(debounceAdapter)
+    { }
+
+template <class PinT, class DebounceT, class SelfT>
+BasicEventSwitch<PinT, DebounceT, SelfT>::~BasicEventSwitch() {
+    if ( ownsDebouncer ) AdapterPool::destroy(debouncer);
+    if ( ownsPinAdapter ) AdapterPool::destroy(pinAdapter);
+}
+
     
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventSwitch<PinT, DebounceT, SelfT>::begin() {
+    pinAdapter->begin();
+    if ( debouncer ) {
+        debouncer->begin();
+    }
+    changedState(InputClock::ms()); //Use to read/set inital state
+    stateChanged = false;
+    edgeCapture = pinAdapter->capturesEdges();
+    edgeState = pinAdapter->read();
+    registerInput();
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventSwitch<PinT, DebounceT, SelfT>::unsetCallback() {
+    callbackFunction = nullptr;
+    EventInputBase::unsetCallback();
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventSwitch<PinT, DebounceT, SelfT>::update(uint32_t nowMs) {
+    if (_enabled) {
+        updateMs = nowMs;
+        if ( edgeCapture ) {
+            processEdges(nowMs);
+        } else if (changedState(nowMs)) {
+            onStateChanged();
+        }
+        EventInputBase::update(nowMs);
+    }
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventSwitch<PinT, DebounceT, SelfT>::onStateChanged() {
+    if (turningOn()) {
+        //previousState = HIGH;
+        invoke(InputEventType::ON);
+    } else if (turningOff()) {
+        invoke(InputEventType::OFF);
+        //previousState = LOW;
+    }
+    stateChanged = false;
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventSwitch<PinT, DebounceT, SelfT>::processEdges(uint32_t nowMs) {
+    PinEdge edge;
+    PinEdge held; // The edge the current pin state started at
+    bool hasHeld = pinAdapter->lastEdge(held);
+    while ( pinAdapter->popEdge(edge) ) {
+        applyPinState(edgeState, edge.ms, hasHeld ? &held : nullptr); // The previous state was held until the edge
+        applyPinState(edge.state, edge.ms, &edge);
+        edgeState = edge.state;
+        held = edge;
+        hasHeld = true;
+    }
+    applyPinState(edgeState, nowMs, hasHeld ? &held : nullptr); // Complete any pending debounce
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventSwitch<PinT, DebounceT, SelfT>::applyPinState(bool pinState, uint32_t ms, const PinEdge* held) {
+    bool state = pinState;
+    if ( debouncer ) {
+        state = debouncer->debounce(pinState, ms);
+        ms = debouncer->changedAtMs();
+    }
+    if ( state != currentState ) {
+        if ( held ) setEventTime(ms, held->ms, held->us); // Exact if the change was at the held edge
+        changeState(state, ms);
+        onStateChanged();
+    }
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventSwitch<PinT, DebounceT, SelfT>::setDebouncer(DebounceT* debounceAdapter) {
+    if ( ownsDebouncer && debounceAdapter != debouncer ) {
+        AdapterPool::destroy(debouncer);
+        ownsDebouncer = false;
+    }
+    debouncer = debounceAdapter;
+    if (debouncer) { //Can pass nullptr to unset?
+        debouncer->setPinAdapter(pinAdapter);
+        debouncer->begin();
+    }
+}
+
+template <class PinT, class DebounceT, class SelfT>
+uint32_t BasicEventSwitch<PinT, DebounceT, SelfT>::nextDeadlineMs(uint32_t nowMs) {
+    uint32_t next = EventInputBase::nextDeadlineMs(nowMs);
+    if ( _enabled && debouncer ) next = min(next, debouncer->msUntilSettled(nowMs));
+    return next;
+}
+
+template <class PinT, class DebounceT, class SelfT>
+bool BasicEventSwitch<PinT, DebounceT, SelfT>::changedState(uint32_t nowMs) {
+    if ( debouncer ) {
+        currentPinState = readDebounced(debouncer, nowMs);
+    } else {
+        currentPinState = readPin(pinAdapter);
+    }
+    if ( changedPinState() && currentPinState != currentState ) {
+            // Stamp with the raw edge that started the change (the debounce interval ago)
+            setEventTime(debouncer ? debouncer->changedAtMs() : nowMs, nowMs, InputClock::us());
+            changeState(currentPinState, nowMs);
+    }
+    return stateChanged;
+}
+
+template <class PinT, class DebounceT, class SelfT>
+bool BasicEventSwitch<PinT, DebounceT, SelfT>::changedPinState() {
+    if ( currentPinState == previousPinState ) return false;
+    previousPinState = currentPinState;
+    return true;
+}
+
+template <class PinT, class DebounceT, class SelfT>
+void BasicEventSwitch<PinT, DebounceT, SelfT>::changeState(bool newState, uint32_t ms) {
+    previousState = currentState;
+    currentState = newState;
+    stateChanged = true;
+    durationOfPreviousState = (InputTicks)(ms - stateChangeLastTime);
+    stateChangeLastTime = ms;
+}
+
+template <class PinT, class DebounceT, class SelfT>
+bool BasicEventSwitch<PinT, DebounceT, SelfT>::setDebounceInterval(unsigned int intervalMs) { 
+    if ( debouncer ) {
+        debouncer->setDebounceInterval(intervalMs);
+        return true;
+    }
+    return false;
+}
+
+template <class PinT, class DebounceT, class SelfT>
+uint32_t BasicEventSwitch<PinT, DebounceT, SelfT>::currentDuration() { return (InputTicks)(InputClock::ms() - stateChangeLastTime); }
+
+class EventSwitch;
 
+// Compiled once in EventSwitch.cpp rather than in every sketch
+extern template class BasicEventSwitch<PinAdapter, DebounceAdapter, EventSwitch>;
+
+/**
+ * @brief An EventSwitch that works with any PinAdapter and DebounceAdapter (via virtual methods).
+ */
+class EventSwitch : public BasicEventSwitch<PinAdapter, DebounceAdapter, EventSwitch> {
+    public:
+    using BasicEventSwitch::BasicEventSwitch;
+};
 
+/**
+ * @brief An EventSwitch with a GpioPinAdapter and the default FoltmanDebounceAdapter as concrete types, 
+ * so reading and debouncing the pin can be inlined into update(). 
+ * 
+ * @details Construct with a pin number as for EventSwitch.
+ */
+class GpioEventSwitch : public BasicEventSwitch<GpioPinAdapter, FoltmanDebounceAdapter, GpioEventSwitch> {
+    public:
+    using BasicEventSwitch::BasicEventSwitch;
 };
 
-#endif
\ No newline at end of file
+#endif
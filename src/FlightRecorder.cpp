@@ -0,0 +1,115 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "FlightRecorder.h"
+#include "Varint.h"
+
+static_assert(INPUT_EVENTS_RECORDER_SIZE >= 16 && INPUT_EVENTS_RECORDER_SIZE <= 32767, "INPUT_EVENTS_RECORDER_SIZE must be 16 to 32767");
+static_assert(NUM_EVENT_TYPE_ENUMS <= 64, "FlightRecorder entries have 6 bits for the InputEventType");
+
+void FlightRecorder::recordEvent(uint8_t inputId, InputEventType et, int16_t payload, uint32_t us) {
+    if ( !enabled ) return;
+    uint8_t entry[2 + 5 + 3];
+    entry[0] = EVENT_BIT | ( payload ? LEVEL_BIT : 0 ) | ( static_cast<uint8_t>(et) & FIELD_MASK );
+    entry[1] = inputId;
+    uint8_t n = 2 + writeDelta(entry + 2, us);
+    if ( payload ) n += writeVarint(entry + n, zigzagEncode(payload));
+    push(entry, n);
+}
+
+void FlightRecorder::clear() {
+    tail = 0;
+    used = 0;
+    count = 0;
+    overwritten = 0;
+}
+
+uint8_t FlightRecorder::writeDelta(uint8_t* out, uint32_t us) {
+    if ( count == 0 ) {
+        // The first entry is the base for the rest
+        tailUs = us;
+        lastUs = us;
+    }
+    // Signed, as edges with captured times can be older than the last entry
+    int32_t delta = (int32_t)(us - lastUs);
+    lastUs = us;
+    return writeVarint(out, zigzagEncode(delta));
+}
+
+void FlightRecorder::push(const uint8_t* entry, uint8_t length) {
+    while ( INPUT_EVENTS_RECORDER_SIZE - used < length ) {
+        dropOldest();
+    }
+    uint16_t head = wrap(tail + used);
+    for ( uint8_t i = 0; i < length; i++ ) {
+        ring[head] = entry[i];
+        if ( ++head == INPUT_EVENTS_RECORDER_SIZE ) head = 0;
+    }
+    used += length;
+    count++;
+}
+
+void FlightRecorder::dropOldest() {
+    uint8_t header, inputId;
+    int32_t deltaUs, payload;
+    uint16_t length = readEntry(0, header, inputId, deltaUs, payload);
+    tailUs += deltaUs;
+    tail = wrap(tail + length);
+    used -= length;
+    count--;
+    overwritten++;
+}
+
+uint32_t FlightRecorder::readVarintAt(uint16_t& offset) {
+    uint32_t value = 0;
+    for ( uint8_t shift = 0; shift < 35; shift += 7 ) {
+        uint8_t b = at(offset++);
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if ( (b & 0x80) == 0 ) break;
+    }
+    return value;
+}
+
+uint16_t FlightRecorder::readEntry(uint16_t offset, uint8_t& header, uint8_t& inputId, int32_t& deltaUs, int32_t& payload) {
+    uint16_t start = offset;
+    header = at(offset++);
+    inputId = 0;
+    payload = 0;
+    if ( header & EVENT_BIT ) inputId = at(offset++);
+    deltaUs = zigzagDecode(readVarintAt(offset));
+    if ( (header & EVENT_BIT) && (header & LEVEL_BIT) ) payload = zigzagDecode(readVarintAt(offset));
+    return offset - start;
+}
+
+void FlightRecorder::dump(Print& out) {
+    out.println("# us,channel,level");
+    uint32_t us = tailUs;
+    uint16_t offset = 0;
+    for ( uint16_t i = 0; i < count; i++ ) {
+        uint8_t header, inputId;
+        int32_t deltaUs, payload;
+        offset += readEntry(offset, header, inputId, deltaUs, payload);
+        us += deltaUs;
+        if ( header & EVENT_BIT ) {
+            out.print("# event ");
+            out.print(us);
+            out.print(',');
+            out.print(inputId);
+            out.print(',');
+            out.print(header & FIELD_MASK);
+            out.print(',');
+            out.println(payload);
+        } else {
+            out.print(us);
+            out.print(',');
+            out.print(header & FIELD_MASK);
+            out.print(',');
+            out.println(( header & LEVEL_BIT ) ? 1 : 0);
+        }
+    }
+}
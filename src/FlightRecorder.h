@@ -0,0 +1,138 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <Arduino.h>
+
+#include "InputEvents.h"
+#include "InputClock.h"
+
+#ifndef INPUT_EVENTS_RECORDER_SIZE
+/**
+ * @brief The number of bytes a FlightRecorder holds (16 to 32767). Can be overridden with a build flag.
+ * @details Entries take 2 to 5 bytes, so the default holds around a hundred - allow about 2.5 bytes per entry.
+ */
+#define INPUT_EVENTS_RECORDER_SIZE 256
+#endif
+
+/**
+ * @brief Keeps the most recent raw pin edges and fired events in a fixed ring of bytes, so you can see 
+ * what happened when an input 'did not respond'.
+ * 
+ * @details Each entry is a header byte and the microseconds since the previous entry as a zigzag varint 
+ * (see Varint.h). Events also have the input ID and, if not 0, the payload. An edge usually takes 2 or 3 
+ * bytes and an event 3 to 5, so the default 256 bytes hold around a hundred entries. When the ring is 
+ * full the oldest entries are overwritten.
+ * 
+ * Edges are recorded by a RecordingPinAdapter. Events are recorded for every input if INPUT_EVENTS_RECORDER 
+ * is defined in your build flags and the recorder is set with InputRegistry::setRecorder().
+ * 
+ * dump() writes the edges in the text format read by CsvReplaySource, with the events as comments, so 
+ * a dump can be replayed with InputReplay.
+ */
+class FlightRecorder {
+
+    public:
+
+    /**
+     * @brief Record a raw pin edge.
+     * 
+     * @param channel 0-63, eg the InputReplay channel the pin will be bound to
+     * @param level The pin level after the edge
+     * @param us The InputClock::us() of the edge
+     */
+    void recordEdge(uint8_t channel, bool level, uint32_t us) {
+        if ( !enabled ) return;
+        uint8_t entry[1 + 5];
+        entry[0] = ( level ? LEVEL_BIT : 0 ) | ( channel & FIELD_MASK );
+        uint8_t n = 1 + writeDelta(entry + 1, us);
+        push(entry, n);
+    }
+
+    /**
+     * @brief Record a raw pin edge now.
+     */
+    void recordEdge(uint8_t channel, bool level) { recordEdge(channel, level, InputClock::us()); }
+
+    /**
+     * @brief Record a fired event. Called by inputs if INPUT_EVENTS_RECORDER is defined.
+     * 
+     * @param inputId The input's ID (see EventInputBase::setInputId())
+     * @param et The event
+     * @param payload The event's payload (see InputEvent)
+     * @param us The event's timestamp (see EventInputBase::eventTimestamp()), so the clock is not read again
+     */
+    void recordEvent(uint8_t inputId, InputEventType et, int16_t payload, uint32_t us);
+
+    /**
+     * @brief Write every entry, oldest first.
+     * 
+     * @details Edges are written as <code>us,channel,level</code> lines and events as 
+     * <code># event us,inputId,type,payload</code> comment lines. Times are InputClock::us(), events are
+     * stamped with their eventTimestamp().
+     */
+    void dump(Print& out);
+
+    /**
+     * @brief Stop (or restart) recording, eg to keep the entries from before a fault until they are dumped.
+     */
+    void enable(bool allow = true) { enabled = allow; }
+
+    /**
+     * @brief Returns true if recording.
+     */
+    bool isEnabled() { return enabled; }
+
+    /**
+     * @brief Remove all entries.
+     */
+    void clear();
+
+    /**
+     * @brief The number of entries held.
+     */
+    uint16_t entryCount() { return count; }
+
+    /**
+     * @brief The number of bytes used.
+     */
+    uint16_t bytesUsed() { return used; }
+
+    /**
+     * @brief The number of entries overwritten since the last clear().
+     */
+    uint32_t overwrittenCount() { return overwritten; }
+
+    private:
+
+    static const uint8_t EVENT_BIT = 0x80;   // Set for events, clear for edges
+    static const uint8_t LEVEL_BIT = 0x40;   // The level of an edge, or set if an event has a payload
+    static const uint8_t FIELD_MASK = 0x3F;  // The channel of an edge or the type of an event
+
+    uint8_t ring[INPUT_EVENTS_RECORDER_SIZE];
+    uint16_t tail = 0;        // The oldest entry
+    uint16_t used = 0;
+    uint16_t count = 0;
+    uint32_t tailUs = 0;      // The time the oldest entry's delta is from
+    uint32_t lastUs = 0;      // The time of the newest entry
+    uint32_t overwritten = 0;
+    bool enabled = true;
+
+    uint8_t writeDelta(uint8_t* out, uint32_t us);
+    void push(const uint8_t* entry, uint8_t length);
+    void dropOldest();
+    uint16_t wrap(uint16_t index) { return index >= INPUT_EVENTS_RECORDER_SIZE ? index - INPUT_EVENTS_RECORDER_SIZE : index; } // index < 2 * size
+    uint8_t at(uint16_t offset) { return ring[wrap(tail + offset)]; }
+    uint32_t readVarintAt(uint16_t& offset);
+    uint16_t readEntry(uint16_t offset, uint8_t& header, uint8_t& inputId, int32_t& deltaUs, int32_t& payload);
+
+};
+
+#endif
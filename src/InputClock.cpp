@@ -0,0 +1,12 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "InputClock.h"
+
+InputClock::ClockFunction InputClock::msSource = nullptr;
+InputClock::ClockFunction InputClock::usSource = nullptr;
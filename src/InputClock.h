@@ -0,0 +1,78 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef INPUT_CLOCK_H
+#define INPUT_CLOCK_H
+
+#include <Arduino.h>
+
+/**
+ * @brief The single source of time for all InputEvents classes.
+ * 
+ * @details By default this is <code>millis()</code> and <code>micros()</code> but a different source can be set, 
+ * eg so a simulation or test can drive time directly:
+ * 
+ * ```cpp
+ * uint32_t simulatedMs = 0;
+ * uint32_t simulatedTime() { return simulatedMs; }
+ * 
+ * InputClock::setSource(simulatedTime);
+ * ```
+ * 
+ * Time is sampled once by InputRegistry::updateAll() (or each input's update()) and then passed 
+ * down to the input and its adapters via the update(nowMs) methods.
+ */
+class InputClock {
+
+    public:
+
+    /**
+     * @brief The type of a function that returns the time.
+     */
+    typedef uint32_t (*ClockFunction)();
+
+    /**
+     * @brief The current time in milliseconds.
+     */
+    static uint32_t ms() { return msSource ? msSource() : millis(); }
+
+    /**
+     * @brief The current time in microseconds.
+     * 
+     * @details If only a milliseconds source has been set, this is derived from it so the two agree.
+     */
+    static uint32_t us() {
+        if ( usSource ) return usSource();
+        return msSource ? msSource() * 1000UL : micros();
+    }
+
+    /**
+     * @brief Set the source of time. 
+     * 
+     * @param msFunction A function returning milliseconds or nullptr to use <code>millis()</code>
+     * @param usFunction A function returning microseconds or nullptr to derive them from msFunction 
+     * (or use <code>micros()</code> if msFunction is also nullptr)
+     */
+    static void setSource(ClockFunction msFunction, ClockFunction usFunction = nullptr) {
+        msSource = msFunction;
+        usSource = usFunction;
+    }
+
+    /**
+     * @brief Go back to using <code>millis()</code> and <code>micros()</code>.
+     */
+    static void resetSource() { setSource(nullptr, nullptr); }
+
+    private:
+
+    static ClockFunction msSource;
+    static ClockFunction usSource;
+
+};
+
+#endif
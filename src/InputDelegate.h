@@ -0,0 +1,137 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_DELEGATE_H
+#define INPUT_DELEGATE_H
+
+#include "InputEvents.h"
+
+#if defined(FUNCTIONAL_SUPPORTED)
+
+#include <functional>
+#include <new>
+#include <string.h>
+#include <type_traits>
+
+#ifndef INPUT_EVENTS_DELEGATE_SIZE
+/**
+ * @brief The number of bytes an InputDelegate can hold inline. Can be overridden with a build flag.
+ * @details The default holds an object pointer and a member function pointer, ie a class method callback.
+ */
+#define INPUT_EVENTS_DELEGATE_SIZE (3 * sizeof(void*))
+#endif
+
+/// \cond DO_NOT_DOCUMENT
+template <typename Signature>
+class InputDelegate;
+/// \endcond
+
+/**
+ * @brief A fixed size callback holder that never allocates memory. Used for every CallbackFunction when
+ * <code>std::function</code> is supported.
+ *
+ * @details Holds a function pointer, a class method (see the setCallback(instance, method) overloads) or a small lambda.
+ * The callable is copied into an inline buffer of INPUT_EVENTS_DELEGATE_SIZE bytes - larger callables
+ * are rejected at compile time rather than allocated on the heap. Callables must be trivially copyable and
+ * destructible (eg lambdas capturing pointers, references or plain values), as a delegate is copied byte for byte.
+ *
+ * Calling an InputDelegate is a single indirect call to a small function generated for the stored type.
+ */
+template <typename R, typename... Args>
+class InputDelegate<R(Args...)> {
+
+    public:
+
+    /**
+     * @brief Construct an empty delegate.
+     */
+    InputDelegate() {}
+
+    /**
+     * @brief Construct an empty delegate (allows <code>callbackFunction = nullptr</code>).
+     */
+    InputDelegate(decltype(nullptr)) {}
+
+    /**
+     * @brief Construct a delegate from a function pointer.
+     */
+    InputDelegate(R (*function)(Args...)) {
+        if ( function ) store(function);
+    }
+
+    /**
+     * @brief Construct a delegate from any other small callable, eg a lambda.
+     */
+    template <typename Callable, typename = typename std::enable_if<
+                std::is_class<typename std::decay<Callable>::type>::value &&
+                !std::is_same<typename std::decay<Callable>::type, InputDelegate>::value>::type>
+    InputDelegate(Callable callable) {
+        store(callable);
+    }
+
+    /**
+     * @brief Returns true if a callable is set.
+     */
+    explicit operator bool() const { return invoker != nullptr; }
+
+    /**
+     * @brief Call the stored callable. Must not be called if empty.
+     */
+    R operator()(Args... args) const {
+        return invoker(storage.bytes, args...);
+    }
+
+    private:
+
+    typedef R (*Invoker)(const void* storage, Args... args);
+
+    template <typename Callable>
+    static R invokeStored(const void* s, Args... args) {
+        return (*static_cast<Callable*>(const_cast<void*>(s)))(args...);
+    }
+
+    template <typename Callable>
+    void store(Callable callable) {
+        static_assert(sizeof(Callable) <= INPUT_EVENTS_DELEGATE_SIZE,
+                      "Callback is too large for InputDelegate - capture less or increase INPUT_EVENTS_DELEGATE_SIZE");
+        static_assert(alignof(Callable) <= alignof(Storage),
+                      "Callback is over-aligned for InputDelegate - capture pointers or references instead");
+        static_assert(std::is_trivially_copyable<Callable>::value,
+                      "Callback must be trivially copyable (capture pointers, references or plain values)");
+        static_assert(std::is_trivially_destructible<Callable>::value,
+                      "Callback must be trivially destructible (capture pointers, references or plain values)");
+        new (storage.bytes) Callable(callable);
+        invoker = &invokeStored<Callable>;
+    }
+
+    union Storage {
+        void* alignPointer;
+        void (*alignFunction)();
+        unsigned char bytes[INPUT_EVENTS_DELEGATE_SIZE];
+        Storage() { memset(bytes, 0, sizeof(bytes)); }
+    } storage;
+
+    Invoker invoker = nullptr;
+
+};
+
+/**
+ * @brief The callback holder used by all InputEvents classes. Define INPUT_EVENTS_STD_FUNCTION in your build flags 
+ * to use <code>std::function</code> instead of InputDelegate (eg for callbacks too large for the delegate).
+ */
+#ifdef INPUT_EVENTS_STD_FUNCTION
+template <typename Signature>
+using InputCallback = std::function<Signature>;
+#else
+template <typename Signature>
+using InputCallback = InputDelegate<Signature>;
+#endif
+
+#endif
+
+#endif
@@ -43,12 +43,67 @@ constexpr auto DISABLED=ACTUAL_DISABLED_VALUE;
 /// \endcond
 
 
+/**
+ * @name Compact Mode
+ * @details Define INPUT_EVENTS_COMPACT in your build flags to reduce the RAM used by each input (eg for 
+ * boards with little RAM and many inputs). In compact mode:
+ * - State flags are packed into bit fields.
+ * - Times are stored as 16 bit milliseconds, so timeouts and durations are limited to 65535ms 
+ *   (a button held for longer will report a wrapped duration).
+ * - EventButtons share one set of ButtonTimings (see EventButton::setTimings()).
+ */
+///@{
+#ifdef INPUT_EVENTS_COMPACT
+    typedef uint16_t InputTicks; ///< A stored time or duration in milliseconds
+    #define INPUT_EVENTS_FLAG : 1 ///< Declares a bool member as a single bit
+#else
+    typedef uint32_t InputTicks; ///< A stored time or duration in milliseconds
+    #define INPUT_EVENTS_FLAG ///< Declares a bool member as a single bit
+#endif
+
+/**
+ * @brief The furthest ahead a stored time can be compared safely across rollover.
+ */
+constexpr InputTicks MAX_TICKS_AHEAD = (InputTicks)(-1) / 2;
+///@}
+
+/// \cond DO_NOT_DOCUMENT
+// The measured size of an input, checked by a static_assert in its .cpp so any growth is a deliberate change.
+// Each list gives the size for 16 (AVR), 32 and 64 bit pointers with the default InputDelegate, then 32 and 64 bit 
+// with (no FUNCTIONAL_SUPPORTED) a function pointer callback. INPUT_EVENTS_SIZE_LIMIT picks the compact or the 
+// default list. Builds with counters, std::function or a different INPUT_EVENTS_DELEGATE_SIZE are not checked.
+#if !defined(INPUT_EVENTS_PERF) && !defined(INPUT_EVENTS_LATENCY) && !defined(INPUT_EVENTS_STD_FUNCTION)
+    #ifdef FUNCTIONAL_SUPPORTED
+        #define INPUT_EVENTS_SIZE_FOR(avr, bits32, bits64, bits32NoFn, bits64NoFn) \
+            ( INPUT_EVENTS_DELEGATE_SIZE != 3 * sizeof(void*) ? (size_t)-1 : sizeof(void*) == 2 ? (size_t)(avr) : \
+              sizeof(void*) == 4 ? (size_t)(bits32) : sizeof(void*) == 8 ? (size_t)(bits64) : (size_t)-1 )
+    #else
+        #define INPUT_EVENTS_SIZE_FOR(avr, bits32, bits64, bits32NoFn, bits64NoFn) \
+            ( sizeof(void*) == 2 ? (size_t)(avr) : sizeof(void*) == 4 ? (size_t)(bits32NoFn) : \
+              sizeof(void*) == 8 ? (size_t)(bits64NoFn) : (size_t)-1 )
+    #endif
+#else
+    #define INPUT_EVENTS_SIZE_FOR(avr, bits32, bits64, bits32NoFn, bits64NoFn) ((size_t)-1)
+#endif
+#ifdef INPUT_EVENTS_COMPACT
+    #define INPUT_EVENTS_SIZE_LIMIT(compact, full) INPUT_EVENTS_SIZE_FOR compact
+#else
+    #define INPUT_EVENTS_SIZE_LIMIT(compact, full) INPUT_EVENTS_SIZE_FOR full
+#endif
+/// \endcond
+
 /**
  * @brief The size of the InputEventType enum
  * 
  */
 constexpr size_t NUM_EVENT_TYPE_ENUMS = 20;
 
+/**
+ * @brief Returned by nextDeadlineMs() when an input has no pending timed event.
+ * 
+ */
+constexpr uint32_t NO_DEADLINE = 0xFFFFFFFF;
+
 /**
  * @brief A list of all events that can be fired by InputEvents classes.
  */
@@ -75,4 +130,22 @@ enum class InputEventType : uint8_t {
     DRAGGED_RELEASED    ///< 19 Fired by EventTouchScreen (experimental)
 };
 
+/**
+ * @brief A set of InputEventTypes, one bit per type (see eventMask()).
+ */
+typedef uint32_t InputEventMask;
+
+static_assert(NUM_EVENT_TYPE_ENUMS <= 32, "InputEventMask must have a bit for every InputEventType");
+
+/**
+ * @brief Returns the InputEventMask bit for an event. Masks can be combined with |
+ * eg <code>eventMask(InputEventType::CLICKED) | eventMask(InputEventType::LONG_CLICKED)</code>
+ */
+constexpr InputEventMask eventMask(InputEventType et) { return (InputEventMask)1 << static_cast<uint8_t>(et); }
+
+/**
+ * @brief An InputEventMask containing every InputEventType.
+ */
+constexpr InputEventMask ALL_EVENTS_MASK = (NUM_EVENT_TYPE_ENUMS == 32) ? 0xFFFFFFFF : (((InputEventMask)1 << NUM_EVENT_TYPE_ENUMS) - 1);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "InputLatency.h"
+
+#ifdef INPUT_EVENTS_LATENCY
+
+InputLatency InputLatency::global;
+
+uint32_t InputLatency::total() {
+    uint32_t n = 0;
+    for ( uint8_t b = 0; b < NUM_BUCKETS; b++ ) n += buckets[b];
+    return n;
+}
+
+uint32_t InputLatency::countWithin(uint32_t us) {
+    uint32_t n = 0;
+    for ( uint8_t b = 0; b < NUM_BUCKETS && bucketMaxUs(b) <= us; b++ ) n += buckets[b];
+    return n;
+}
+
+uint32_t InputLatency::percentileUs(uint8_t percent) {
+    uint32_t n = total();
+    if ( n == 0 ) return 0;
+    // The rank of the percentile, rounded up
+    uint32_t rank = ( n * min(percent, (uint8_t)100) + 99 ) / 100;
+    uint32_t seen = 0;
+    for ( uint8_t b = 0; b < NUM_BUCKETS; b++ ) {
+        seen += buckets[b];
+        if ( seen >= rank && seen > 0 ) return min(bucketMaxUs(b), maxLatencyUs);
+    }
+    return maxLatencyUs;
+}
+
+void InputLatency::print(Print& out) {
+    for ( uint8_t b = 0; b < NUM_BUCKETS; b++ ) {
+        if ( buckets[b] ) {
+            out.print(" <=");
+            out.print(bucketMaxUs(b));
+            out.print(":");
+            out.print(buckets[b]);
+        }
+    }
+    out.print(" total:");
+    out.print(total());
+    out.print(" maxUs:");
+    out.println(maxLatencyUs);
+}
+
+#endif
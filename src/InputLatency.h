@@ -0,0 +1,112 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <Arduino.h>
+
+#include "InputEvents.h"
+
+/**
+ * @brief A histogram of the latency from an event's trigger (see EventInputBase::eventTimestamp()) to 
+ * the start of its callback. Only compiled in if INPUT_EVENTS_LATENCY is defined in your build flags.
+ * 
+ * @details Buckets are powers of two in microseconds: bucket 0 counts a latency of 0us, bucket b counts
+ * latencies from 2^(b-1) to 2^b - 1 us and the last bucket counts everything from 2^(NUM_BUCKETS-2) us (~4s) up.
+ * Counts stop at 65535. No memory is allocated.
+ * 
+ * For a button pressed or released on a debounced pin the trigger is the raw pin edge, so the latency 
+ * includes the debounce interval. For click events it is the release edge, so it also includes the 
+ * multi-click wait. Both include the time until update() was next called.
+ * 
+ * Each input has its own histogram (see EventInputBase::latencyHistogram()) and every latency is also 
+ * added to InputLatency::global (except those of inputs owned by another, eg the button of an EventEncoderButton).
+ */
+class InputLatency {
+    public:
+
+    static const uint8_t NUM_BUCKETS = 24; ///< The number of buckets
+
+    static InputLatency global; ///< The latency of every event of every input
+
+    /**
+     * @brief Add one latency.
+     */
+    void record(uint32_t us) {
+        uint8_t b = bucketOf(us);
+        if ( buckets[b] != UINT16_MAX ) buckets[b]++;
+        if ( us > maxLatencyUs ) maxLatencyUs = us;
+    }
+
+    /**
+     * @brief The number of latencies in a bucket.
+     */
+    uint16_t count(uint8_t bucket) { return bucket < NUM_BUCKETS ? buckets[bucket] : 0; }
+
+    /**
+     * @brief The number of latencies in all buckets.
+     */
+    uint32_t total();
+
+    /**
+     * @brief The largest latency recorded.
+     */
+    uint32_t maxUs() { return maxLatencyUs; }
+
+    /**
+     * @brief The largest latency (in microseconds) counted in a bucket.
+     */
+    static uint32_t bucketMaxUs(uint8_t bucket) {
+        return bucket >= NUM_BUCKETS - 1 ? UINT32_MAX : ( 1UL << bucket ) - 1;
+    }
+
+    /**
+     * @brief The bucket a latency is counted in.
+     */
+    static uint8_t bucketOf(uint32_t us) {
+        uint8_t b = 0;
+        while ( us && b < NUM_BUCKETS - 1 ) {
+            us >>= 1;
+            b++;
+        }
+        return b;
+    }
+
+    /**
+     * @brief The number of latencies that are certainly no more than a limit, ie in buckets whose largest 
+     * latency is within the limit.
+     * 
+     * @param us The limit in microseconds, eg 20000 for 20ms
+     */
+    uint32_t countWithin(uint32_t us);
+
+    /**
+     * @brief An upper bound of a percentile: the largest latency of the bucket that holds it.
+     * 
+     * @param percent 0-100, eg 99 for the 99th percentile
+     * @return The latency in microseconds, or 0 if nothing has been recorded
+     */
+    uint32_t percentileUs(uint8_t percent);
+
+    /**
+     * @brief Print the non-empty buckets on one line as <code>&lt;=maxUs:count</code>, followed by the total and maximum.
+     */
+    void print(Print& out);
+
+    /**
+     * @brief Clear all counts.
+     */
+    void reset() { *this = InputLatency(); }
+
+    private:
+    uint16_t buckets[NUM_BUCKETS] = {0};
+    uint32_t maxLatencyUs = 0;
+};
+
+#endif
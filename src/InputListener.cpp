@@ -0,0 +1,23 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "InputListener.h"
+#include "EventInputBase.h"
+
+InputListener::~InputListener() {
+    if ( input ) {
+        input->removeListener(this);
+    }
+}
+
+void InputListener::setEvents(InputEventMask mask) {
+    events = mask;
+    if ( input ) {
+        input->refreshListenerEvents();
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef INPUT_LISTENER_H
+#define INPUT_LISTENER_H
+
+#include <Arduino.h>
+
+#include "InputEvents.h"
+
+#include "InputDelegate.h"
+
+class EventInputBase;
+
+/**
+ * @brief An additional receiver of an input's events, with its own set of events.
+ * 
+ * @details An input has one callback but any number of listeners, so (for example) a UI, a logger and 
+ * a USB HID bridge can all receive the same button's events without being chained in one function.
+ * 
+ * Each listener has an InputEventMask of the events it wants. The input keeps the union of its listeners' 
+ * masks, so an event no listener wants costs a single bit test. Listeners are called in the order they 
+ * were added, immediately before the input's callback (or before the event is queued if the input has an 
+ * EventQueue). Events blocked with blockEvent() are not sent to listeners.
+ * 
+ * A listener is linked into the input it listens to, so there is no allocation, but it can only listen to 
+ * one input at a time. Create one listener per input (they can share the same function).
+ * 
+ * ```cpp
+ * void logEvent(InputEventType et, EventInputBase& input) { ... }
+ * 
+ * InputListener logger(logEvent);
+ * InputListener clicks(onClick, eventMask(InputEventType::CLICKED) | eventMask(InputEventType::DOUBLE_CLICKED));
+ * 
+ * void setup() {
+ *     myButton.begin();
+ *     myButton.setCallback(onButtonEvent);
+ *     myButton.addListener(&logger);
+ *     myButton.addListener(&clicks);
+ * }
+ * ```
+ */
+class InputListener {
+
+    friend class EventInputBase;
+
+    public:
+
+    #if defined(FUNCTIONAL_SUPPORTED)
+        /**
+         * @brief If <code>std::function</code> is supported, this creates the listener function type (a heap free InputDelegate by default).
+         */
+        typedef InputCallback<void(InputEventType et, EventInputBase &input)> ListenerFunction;
+    #else
+        /**
+         * @brief Used to create the listener function type as pointer if <code>std::function</code> is not supported.
+         */
+        typedef void (*ListenerFunction)(InputEventType et, EventInputBase &input);
+    #endif
+
+    /**
+     * @brief Construct a listener.
+     * 
+     * @param function Called with each event in the mask. The input is passed as its base class - 
+     * cast it (eg <code>static_cast<EventButton&>(input)</code>) if you need the derived class.
+     * @param events The events to receive (default all)
+     */
+    InputListener(ListenerFunction function, InputEventMask events = ALL_EVENTS_MASK)
+        : function(function), events(events) {}
+
+    /**
+     * @brief Construct a listener without a function (eg in an array). Call setFunction() before adding it to an input.
+     */
+    InputListener() : function(nullptr), events(ALL_EVENTS_MASK) {}
+
+    /**
+     * @brief Removes the listener from its input (if any).
+     */
+    ~InputListener();
+
+    InputListener(const InputListener&) = delete; // Linked into an input's list
+    InputListener& operator=(const InputListener&) = delete;
+
+    /**
+     * @brief Set the function called with each event in the mask.
+     */
+    void setFunction(ListenerFunction f) { function = f; }
+
+    /**@{
+     * @name Event Mask
+     */
+
+    /**
+     * @brief Receive this event.
+     */
+    void listenTo(InputEventType et) { setEvents(events | eventMask(et)); }
+
+    /**
+     * @brief Stop receiving this event.
+     */
+    void ignore(InputEventType et) { setEvents(events & ~eventMask(et)); }
+
+    /**
+     * @brief Replace the set of events received.
+     * 
+     * @param mask eg <code>eventMask(InputEventType::ON) | eventMask(InputEventType::OFF)</code> or ALL_EVENTS_MASK
+     */
+    void setEvents(InputEventMask mask);
+
+    /**
+     * @brief Returns the set of events received.
+     */
+    InputEventMask getEvents() { return events; }
+
+    /**
+     * @brief Returns true if this event is received.
+     */
+    bool isListeningTo(InputEventType et) { return (events & eventMask(et)) != 0; }
+    ///@}
+
+    /**
+     * @brief Returns the input this listener has been added to (or nullptr).
+     */
+    EventInputBase* getInput() { return input; }
+
+    private:
+
+    ListenerFunction function;
+    InputEventMask events;
+    EventInputBase* input = nullptr;
+    InputListener* nextListener = nullptr;
+
+};
+
+#endif
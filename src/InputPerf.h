@@ -0,0 +1,65 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef INPUT_PERF_H
+#define INPUT_PERF_H
+
+#include <Arduino.h>
+
+#include "InputEvents.h"
+#include "InputClock.h"
+
+/**
+ * @brief Performance counters for one input. Only compiled in if INPUT_EVENTS_PERF is defined in your build flags.
+ * 
+ * @details Read with EventInputBase::perfCounters() or print the counters of every registered input 
+ * with InputRegistry::printPerf(). Times are in microseconds from InputClock::us() and include the 
+ * overhead of reading the clock (a few microseconds on AVR).
+ */
+struct InputPerf {
+    uint32_t updates = 0;        ///< Number of update() calls (via update() or InputRegistry::updateAll())
+    uint32_t updateUs = 0;       ///< Total time spent in update(), including callbacks
+    uint32_t updateMaxUs = 0;    ///< The longest single update()
+    uint32_t callbackUs = 0;     ///< Total time spent in the callback, per-event handlers and listeners
+    uint32_t callbackMaxUs = 0;  ///< The longest single callback
+    uint16_t suppressed = 0;     ///< Events not fired because they were blocked (see blockEvent())
+    uint16_t fired[NUM_EVENT_TYPE_ENUMS] = {0}; ///< Events fired (or queued), by InputEventType
+
+    /**
+     * @brief Add the time of one update().
+     */
+    void addUpdate(uint32_t us) {
+        updates++;
+        updateUs += us;
+        if ( us > updateMaxUs ) updateMaxUs = us;
+    }
+
+    /**
+     * @brief Add the time of one callback.
+     */
+    void addCallback(uint32_t us) {
+        callbackUs += us;
+        if ( us > callbackMaxUs ) callbackMaxUs = us;
+    }
+
+    /**
+     * @brief The total number of events fired (or queued).
+     */
+    uint32_t firedCount() {
+        uint32_t n = 0;
+        for ( uint8_t i = 0; i < NUM_EVENT_TYPE_ENUMS; i++ ) n += fired[i];
+        return n;
+    }
+
+    /**
+     * @brief Clear all counters.
+     */
+    void reset() { *this = InputPerf(); }
+};
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "InputRegistry.h"
+
+EventInputBase* InputRegistry::head = nullptr;
+EventInputBase* InputRegistry::tail = nullptr;
+EventQueue* InputRegistry::eventQueue = nullptr;
+EventInputBase* InputRegistry::cursor = nullptr;
+#ifdef INPUT_EVENTS_RECORDER
+FlightRecorder* InputRegistry::flightRecorder = nullptr;
+#endif
+
+void InputRegistry::updateAll() {
+    updateAll(InputClock::ms());
+}
+
+void InputRegistry::updateAll(uint32_t nowMs) {
+    // The next input is saved first, a callback may destroy (or remove) the input it was called for
+    for ( EventInputBase* input = head; input != nullptr; input = cursor ) {
+        cursor = input->nextInput;
+        if ( input->_enabled ) {
+            input->measuredUpdate(nowMs);
+        }
+    }
+    if ( eventQueue ) {
+        eventQueue->dispatch();
+    }
+}
+
+void InputRegistry::setEventQueue(EventQueue* queue) {
+    eventQueue = queue; // Inputs without their own queue use it (see EventInputBase::getEventQueue())
+}
+
+uint32_t InputRegistry::nextDeadlineMs() {
+    uint32_t nowMs = InputClock::ms();
+    uint32_t next = NO_DEADLINE;
+    for ( EventInputBase* input = head; input != nullptr && next != 0; input = input->nextInput ) {
+        if ( input->_enabled ) {
+            next = min(next, input->nextDeadlineMs(nowMs));
+        }
+    }
+    return next;
+}
+
+void InputRegistry::add(EventInputBase* input) {
+    if ( input == nullptr || contains(input) ) return;
+    input->nextInput = nullptr;
+    if ( tail ) {
+        tail->nextInput = input;
+    } else {
+        head = input;
+    }
+    tail = input;
+}
+
+void InputRegistry::remove(EventInputBase* input) {
+    EventInputBase* prev = nullptr;
+    for ( EventInputBase* i = head; i != nullptr; i = i->nextInput ) {
+        if ( i == input ) {
+            if ( cursor == i ) {
+                cursor = i->nextInput; // Removed during updateAll(), skip to the input after it
+            }
+            if ( prev ) {
+                prev->nextInput = i->nextInput;
+            } else {
+                head = i->nextInput;
+            }
+            if ( tail == i ) {
+                tail = prev;
+            }
+            i->nextInput = nullptr;
+            return;
+        }
+        prev = i;
+    }
+}
+
+bool InputRegistry::contains(EventInputBase* input) {
+    // Only the tail has a null link once registered
+    return input == tail || input->nextInput != nullptr;
+}
+
+uint16_t InputRegistry::count() {
+    uint16_t n = 0;
+    for ( EventInputBase* i = head; i != nullptr; i = i->nextInput ) {
+        n++;
+    }
+    return n;
+}
+
+#ifdef INPUT_EVENTS_PERF
+
+void InputRegistry::printPerf(Print& out) {
+    uint16_t n = 0;
+    for ( EventInputBase* i = head; i != nullptr; i = i->nextInput ) {
+        InputPerf& p = i->perfCounters();
+        out.print("#");
+        out.print(n++);
+        out.print(" id:");
+        out.print(i->getInputId());
+        out.print(" updates:");
+        out.print(p.updates);
+        out.print(" avgUs:");
+        out.print(p.updates ? p.updateUs / p.updates : 0);
+        out.print(" maxUs:");
+        out.print(p.updateMaxUs);
+        out.print(" callbackUs:");
+        out.print(p.callbackUs);
+        out.print(" callbackMaxUs:");
+        out.print(p.callbackMaxUs);
+        out.print(" suppressed:");
+        out.print(p.suppressed);
+        out.print(" events:");
+        for ( uint8_t et = 0; et < NUM_EVENT_TYPE_ENUMS; et++ ) {
+            if ( p.fired[et] ) {
+                out.print(" ");
+                out.print(et);
+                out.print("=");
+                out.print(p.fired[et]);
+            }
+        }
+        out.println();
+    }
+}
+
+void InputRegistry::resetPerf() {
+    for ( EventInputBase* i = head; i != nullptr; i = i->nextInput ) {
+        i->resetPerfCounters();
+    }
+}
+
+#endif
+
+#ifdef INPUT_EVENTS_LATENCY
+
+void InputRegistry::printLatency(Print& out) {
+    uint16_t n = 0;
+    for ( EventInputBase* i = head; i != nullptr; i = i->nextInput ) {
+        out.print("#");
+        out.print(n++);
+        out.print(" id:");
+        out.print(i->getInputId());
+        i->latencyHistogram().print(out);
+    }
+    out.print("all");
+    InputLatency::global.print(out);
+}
+
+void InputRegistry::resetLatency() {
+    for ( EventInputBase* i = head; i != nullptr; i = i->nextInput ) {
+        i->latencyHistogram().reset();
+    }
+    InputLatency::global.reset();
+}
+
+#endif
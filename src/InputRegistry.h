@@ -0,0 +1,176 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef INPUT_REGISTRY_H
+#define INPUT_REGISTRY_H
+
+#include <Arduino.h>
+#include "EventInputBase.h"
+#include "EventQueue.h"
+#include "FlightRecorder.h"
+
+/**
+ * @brief A single list of all inputs so they can be updated with one call from <code>loop()</code>.
+ * 
+ * @details Inputs add themselves to the registry when their begin() method is called (unless
+ * enableAutoRegister(false) has been called) and remove themselves when destroyed.
+ * 
+ * The list is intrusive - the link is held in each input so there is no allocation and no 
+ * separate list nodes to chase. Inputs are updated in the order begin() was called.
+ * 
+ * ```cpp
+ * void loop() {
+ *     InputRegistry::updateAll();
+ * }
+ * ```
+ * 
+ */
+class InputRegistry {
+
+    public:
+
+    /**
+     * @brief Update every registered input. Disabled inputs are skipped entirely.
+     * 
+     * @details Call this from <code>loop()</code> instead of calling update() on each input.
+     * If setEventQueue() has been called, the queue's batch callback (if set) is then called once 
+     * with all the events fired during this update.
+     * 
+     * The time is sampled once from InputClock::ms() so every input agrees on 'now'.
+     * 
+     * A callback may remove or destroy other inputs during updateAll() (not its own, which is still in its
+     * update()), but must not call updateAll().
+     */
+    static void updateAll();
+
+    /**
+     * @brief Update every registered, enabled input with a time already sampled from InputClock::ms().
+     * 
+     * @param nowMs The current time in milliseconds
+     */
+    static void updateAll(uint32_t nowMs);
+
+    /**
+     * @brief Queue the events of all registered inputs, including those registered later.
+     * 
+     * @details Used by every input that does not have its own queue (see EventInputBase::setEventQueue()), 
+     * except inputs owned by another input. Pass nullptr to remove the registry's queue from those inputs.
+     * 
+     * @param queue The EventQueue or nullptr
+     */
+    static void setEventQueue(EventQueue* queue);
+
+    /**
+     * @brief Returns the queue set with setEventQueue() (or nullptr).
+     */
+    static EventQueue* getEventQueue() { return eventQueue; }
+
+    /**
+     * @brief The number of milliseconds until the earliest deadline of any registered, enabled input.
+     * 
+     * @details Use this to sleep or do other work in <code>loop()</code>. Pin changes are not 
+     * deadlines, so only sleep this long if pin changes will also wake the board.
+     * 
+     * @return uint32_t Milliseconds until the next deadline, 0 if due now or NO_DEADLINE
+     */
+    static uint32_t nextDeadlineMs();
+
+    /**
+     * @brief Add an input to the registry. Called automatically by begin(). Adding an input twice has no effect.
+     * 
+     * @param input The input to add
+     */
+    static void add(EventInputBase* input);
+
+    /**
+     * @brief Remove an input from the registry. Called automatically when an input is destroyed.
+     * 
+     * @param input The input to remove
+     */
+    static void remove(EventInputBase* input);
+
+    /**
+     * @brief Returns true if the input is in the registry.
+     */
+    static bool contains(EventInputBase* input);
+
+    /**
+     * @brief The number of registered inputs.
+     */
+    static uint16_t count();
+
+    /**
+     * @brief The first registered input (or nullptr). Use with next() to iterate the registry.
+     */
+    static EventInputBase* first() { return head; }
+
+    /**
+     * @brief The input registered after the passed input (or nullptr).
+     */
+    static EventInputBase* next(EventInputBase* input) { return input->nextInput; }
+
+    #ifdef INPUT_EVENTS_PERF
+    /**
+     * @brief Print the performance counters of every registered input, one line per input in registry order.
+     * 
+     * @details Only available if INPUT_EVENTS_PERF is defined. Each line shows the input's position 
+     * in the registry, its ID (see setInputId()), the number of updates, the average and maximum update 
+     * time, the total and maximum callback time, the number of suppressed events and the number of each 
+     * type of event fired. Times are in microseconds.
+     * 
+     * @param out Where to print, eg <code>Serial</code>
+     */
+    static void printPerf(Print& out);
+
+    /**
+     * @brief Clear the performance counters of every registered input.
+     */
+    static void resetPerf();
+    #endif
+
+    #ifdef INPUT_EVENTS_RECORDER
+    /**
+     * @brief Record the events of every input in a FlightRecorder. Pass nullptr to stop.
+     * @details Only available if INPUT_EVENTS_RECORDER is defined in your build flags.
+     */
+    static void setRecorder(FlightRecorder* recorder) { flightRecorder = recorder; }
+
+    /**
+     * @brief Returns the recorder set with setRecorder() (or nullptr).
+     */
+    static FlightRecorder* getRecorder() { return flightRecorder; }
+    #endif
+
+    #ifdef INPUT_EVENTS_LATENCY
+    /**
+     * @brief Print the latency histogram of every registered input, one line per input in registry order, 
+     * followed by the global histogram (see InputLatency::print()).
+     * 
+     * @param out Where to print, eg <code>Serial</code>
+     */
+    static void printLatency(Print& out);
+
+    /**
+     * @brief Clear the latency histograms of every registered input and the global histogram.
+     */
+    static void resetLatency();
+    #endif
+
+    private:
+
+    static EventInputBase* head;
+    static EventInputBase* tail;
+    static EventQueue* eventQueue;
+    static EventInputBase* cursor; // The next input to update in updateAll()
+    #ifdef INPUT_EVENTS_RECORDER
+    static FlightRecorder* flightRecorder;
+    #endif
+
+};
+
+#endif
@@ -0,0 +1,242 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "InputReplay.h"
+#include "Varint.h"
+
+uint32_t InputReplay::simulatedMs = 0;
+uint32_t InputReplay::simulatedUs = 0;
+uint16_t InputReplay::usRemainder = 0;
+
+bool CsvReplaySource::next(ReplaySample& sample) {
+    int32_t values[3];
+    if ( !InputReplay::readCsvLine(in, values, 3) ) return false;
+    sample.us = (uint32_t)values[0];
+    sample.channel = (uint8_t)values[1];
+    sample.value = values[2];
+    return true;
+}
+
+bool BinaryReplaySource::next(ReplaySample& sample) {
+    uint32_t deltaUs, value;
+    uint8_t n = readVarint(data + pos, length - pos, deltaUs);
+    if ( n == 0 || pos + n >= length ) return false;
+    size_t p = pos + n;
+    sample.channel = data[p++];
+    n = readVarint(data + p, length - p, value);
+    if ( n == 0 ) return false;
+    pos = p + n;
+    us += deltaUs;
+    sample.us = us;
+    sample.value = zigzagDecode(value);
+    return true;
+}
+
+uint8_t BinaryReplaySource::append(uint8_t* buffer, size_t size, uint32_t deltaUs, uint8_t channel, int32_t value) {
+    uint32_t zigzag = zigzagEncode(value);
+    uint8_t n = varintSize(deltaUs) + 1 + varintSize(zigzag);
+    if ( n > size ) return 0;
+    uint8_t p = writeVarint(buffer, deltaUs);
+    buffer[p++] = channel;
+    writeVarint(buffer + p, zigzag);
+    return n;
+}
+
+InputReplay::InputReplay() {
+    simulatedMs = 0;
+    simulatedUs = 0;
+    usRemainder = 0;
+    InputClock::setSource(clockMs, clockUs);
+}
+
+InputReplay::~InputReplay() {
+    InputClock::resetSource();
+}
+
+bool InputReplay::bindPin(uint8_t channel, VirtualPinAdapter* pin) {
+    if ( channel >= INPUT_EVENTS_REPLAY_CHANNELS ) return false;
+    bindings[channel].type = pin ? ChannelType::PIN : ChannelType::NONE;
+    bindings[channel].pin = pin;
+    return true;
+}
+
+bool InputReplay::bindAnalog(uint8_t channel, VirtualAnalogAdapter* analog) {
+    if ( channel >= INPUT_EVENTS_REPLAY_CHANNELS ) return false;
+    bindings[channel].type = analog ? ChannelType::ANALOG : ChannelType::NONE;
+    bindings[channel].analog = analog;
+    return true;
+}
+
+#ifndef EXCLUDE_EVENT_ENCODER
+bool InputReplay::bindEncoder(uint8_t channel, EncoderAdapter* encoder) {
+    if ( channel >= INPUT_EVENTS_REPLAY_CHANNELS ) return false;
+    bindings[channel].type = encoder ? ChannelType::ENCODER : ChannelType::NONE;
+    bindings[channel].encoder = encoder;
+    return true;
+}
+#endif
+
+bool InputReplay::bindFunction(uint8_t channel, SampleFunction function) {
+    if ( channel >= INPUT_EVENTS_REPLAY_CHANNELS ) return false;
+    bindings[channel].type = function ? ChannelType::FUNCTION : ChannelType::NONE;
+    bindings[channel].function = function;
+    return true;
+}
+
+ReplayResult InputReplay::run(ReplaySource& source) {
+    ReplayResult result;
+    EventQueue* previousQueue = InputRegistry::getEventQueue();
+    InputRegistry::setEventQueue(&queue);
+    queue.clear();
+    uint32_t startUs = micros();
+    uint32_t startMs = simulatedMs;
+    uint32_t originUs = simulatedUs; // Simulated time of the first sample
+    uint32_t firstUs = 0;
+    bool first = true;
+    bool pending = false;
+    ReplaySample sample;
+    while ( source.next(sample) ) {
+        if ( first ) {
+            firstUs = sample.us;
+            first = false;
+        }
+        uint32_t targetUs = originUs + (sample.us - firstUs);
+        if ( (int32_t)(targetUs - simulatedUs) > 0 ) {
+            // Samples at the same time are applied together, then updated
+            if ( pending ) step(result);
+            advanceTo(targetUs, result);
+        }
+        apply(sample, result);
+        pending = true;
+    }
+    if ( pending ) step(result);
+    advanceTo(simulatedUs + settleMs * 1000UL, result);
+    step(result);
+    // Anything left in the golden file was not fired
+    int32_t values[4];
+    while ( golden && readCsvLine(*golden, values, 4) ) {
+        if ( result.firstMismatch < 0 ) result.firstMismatch = result.events;
+        result.mismatches++;
+    }
+    result.dropped = queue.droppedCount();
+    result.simulatedMs = simulatedMs - startMs;
+    result.elapsedUs = micros() - startUs;
+    InputRegistry::setEventQueue(previousQueue);
+    return result;
+}
+
+void InputReplay::apply(const ReplaySample& sample, ReplayResult& result) {
+    Binding* binding = sample.channel < INPUT_EVENTS_REPLAY_CHANNELS ? &bindings[sample.channel] : nullptr;
+    switch ( binding ? binding->type : ChannelType::NONE ) {
+        case ChannelType::PIN:
+            binding->pin->setState(sample.value != 0);
+            break;
+        case ChannelType::ANALOG:
+            binding->analog->setValue((uint16_t)sample.value);
+            break;
+        #ifndef EXCLUDE_EVENT_ENCODER
+        case ChannelType::ENCODER:
+            binding->encoder->setPosition(sample.value);
+            break;
+        #endif
+        case ChannelType::FUNCTION:
+            binding->function(sample.channel, sample.value);
+            break;
+        default:
+            result.ignored++;
+            return;
+    }
+    result.samples++;
+}
+
+void InputReplay::advance(uint32_t us) {
+    simulatedUs += us;
+    uint32_t remainder = usRemainder + us % 1000;
+    simulatedMs += us / 1000 + remainder / 1000;
+    usRemainder = remainder % 1000;
+}
+
+void InputReplay::advanceTo(uint32_t targetUs, ReplayResult& result) {
+    while ( (int32_t)(targetUs - simulatedUs) > 0 ) {
+        uint32_t remainingUs = targetUs - simulatedUs;
+        uint32_t waitMs = InputRegistry::nextDeadlineMs();
+        if ( pollMs && pollMs < waitMs ) waitMs = pollMs;
+        if ( waitMs == 0 ) waitMs = 1; // Due now, so already handled by the last update
+        if ( waitMs > remainingUs / 1000 ) {
+            advance(remainingUs);
+            return;
+        }
+        advance(waitMs * 1000UL);
+        step(result);
+    }
+}
+
+void InputReplay::step(ReplayResult& result) {
+    InputRegistry::updateAll();
+    result.updates++;
+    InputEvent e;
+    while ( queue.poll(e) ) {
+        check(e, result);
+    }
+}
+
+void InputReplay::check(const InputEvent& e, ReplayResult& result) {
+    if ( eventLog ) {
+        eventLog->print(e.ms);
+        eventLog->print(',');
+        eventLog->print(e.inputId);
+        eventLog->print(',');
+        eventLog->print((uint8_t)e.type);
+        eventLog->print(',');
+        eventLog->println(e.payload);
+    }
+    if ( golden ) {
+        int32_t values[4];
+        bool matched = readCsvLine(*golden, values, 4)
+            && (uint32_t)values[0] == e.ms
+            && values[1] == e.inputId
+            && values[2] == (uint8_t)e.type
+            && values[3] == e.payload;
+        if ( !matched ) {
+            if ( result.firstMismatch < 0 ) result.firstMismatch = result.events;
+            result.mismatches++;
+        }
+    }
+    result.events++;
+}
+
+bool InputReplay::readCsvLine(Stream& in, int32_t* values, uint8_t count) {
+    int c = in.read();
+    // Skip blank and comment lines
+    while ( c == '\r' || c == '\n' || c == '#' ) {
+        if ( c == '#' ) {
+            while ( c >= 0 && c != '\n' ) c = in.read();
+        }
+        c = in.read();
+    }
+    if ( c < 0 ) return false;
+    uint8_t n = 0;
+    uint32_t value = 0;
+    bool negative = false;
+    for ( ;; c = in.read() ) {
+        if ( c >= '0' && c <= '9' ) {
+            value = value * 10 + (c - '0');
+        } else if ( c == '-' ) {
+            negative = true;
+        } else if ( c == ',' || c == '\n' || c == '\r' || c < 0 ) {
+            if ( n < count ) values[n++] = (int32_t)(negative ? 0 - value : value);
+            value = 0;
+            negative = false;
+            if ( c != ',' ) break;
+        }
+        // Anything else (eg spaces) is ignored
+    }
+    if ( c == '\r' && in.peek() == '\n' ) in.read();
+    while ( n < count ) values[n++] = 0;
+    return true;
+}
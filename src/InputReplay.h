@@ -0,0 +1,296 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <Arduino.h>
+
+#include "InputEvents.h"
+#include "InputClock.h"
+#include "InputRegistry.h"
+#include "EventQueue.h"
+#include "PinAdapter/VirtualPinAdapter.h"
+#include "AnalogAdapter/VirtualAnalogAdapter.h"
+
+#ifndef EXCLUDE_EVENT_ENCODER
+#include <EncoderAdapter.h>
+#endif
+
+#ifndef INPUT_EVENTS_REPLAY_CHANNELS
+/**
+ * @brief The number of channels an InputReplay can bind. Can be overridden with a build flag.
+ */
+#define INPUT_EVENTS_REPLAY_CHANNELS 16
+#endif
+
+/**
+ * @brief One recorded sample: a pin level, encoder count or analog value on a channel.
+ */
+struct ReplaySample {
+    uint32_t us;     ///< The time of the sample in microseconds (only the difference between samples is used)
+    uint8_t channel; ///< The channel, see InputReplay::bindPin() etc
+    int32_t value;   ///< The pin level (0 or 1), encoder count or analog value
+};
+
+/**
+ * @brief The interface for a source of recorded samples, in time order.
+ */
+class ReplaySource {
+    public:
+    virtual ~ReplaySource() {}
+
+    /**
+     * @brief Read the next sample.
+     *
+     * @return false if there are no more samples
+     */
+    virtual bool next(ReplaySample& sample) = 0;
+};
+
+/**
+ * @brief Reads samples from text, one per line as <code>us,channel,value</code>. Blank lines
+ * and lines starting with <code>#</code> are skipped.
+ *
+ * @details The stream must return all its data without waiting, eg an SD card File.
+ * Times may be larger than 32 bits, only the difference between samples is used.
+ */
+class CsvReplaySource : public ReplaySource {
+    public:
+    CsvReplaySource(Stream& in) : in(in) {}
+
+    bool next(ReplaySample& sample) override;
+
+    private:
+    Stream& in;
+};
+
+/**
+ * @brief Reads samples from a compact binary recording in memory.
+ *
+ * @details Each sample is the microseconds since the previous sample (the first since 0) as a varint,
+ * the channel as one byte and the value as a zigzag varint (see Varint.h). A pin edge usually takes
+ * 3 or 4 bytes. Use append() to build a recording.
+ */
+class BinaryReplaySource : public ReplaySource {
+    public:
+    BinaryReplaySource(const uint8_t* data, size_t length) : data(data), length(length) {}
+
+    bool next(ReplaySample& sample) override;
+
+    /**
+     * @brief Go back to the first sample.
+     */
+    void rewind() { pos = 0; us = 0; }
+
+    /**
+     * @brief Write one sample to a recording.
+     *
+     * @param buffer Where to write
+     * @param size The bytes available in buffer
+     * @param deltaUs Microseconds since the previous sample
+     * @param channel The channel
+     * @param value The value
+     * @return The number of bytes written, 0 if they do not fit
+     */
+    static uint8_t append(uint8_t* buffer, size_t size, uint32_t deltaUs, uint8_t channel, int32_t value);
+
+    private:
+    const uint8_t* data;
+    size_t length;
+    size_t pos = 0;
+    uint32_t us = 0;
+};
+
+/**
+ * @brief The outcome of InputReplay::run().
+ */
+struct ReplayResult {
+    uint32_t samples = 0;       ///< Samples applied
+    uint32_t ignored = 0;       ///< Samples for channels that are not bound
+    uint32_t updates = 0;       ///< InputRegistry::updateAll() calls
+    uint32_t events = 0;        ///< Events fired
+    uint32_t mismatches = 0;    ///< Events that differ from (or are missing from) the golden file
+    int32_t firstMismatch = -1; ///< The index of the first mismatched event (from 0), -1 if none
+    uint16_t dropped = 0;       ///< Events lost because the queue was full (they are not compared)
+    uint32_t simulatedMs = 0;   ///< The time replayed
+    uint32_t elapsedUs = 0;     ///< The real time the replay took, from <code>micros()</code>
+
+    /**
+     * @brief Replay throughput.
+     */
+    uint32_t samplesPerSecond() { return elapsedUs ? (uint32_t)((uint64_t)samples * 1000000UL / elapsedUs) : 0; }
+
+    /**
+     * @brief True if every event matched the golden file (and none were dropped).
+     */
+    bool passed() { return mismatches == 0 && dropped == 0; }
+};
+
+/**
+ * @brief Replays a recording of raw pin levels, encoder counts and analog values through the
+ * registered inputs, much faster than real time.
+ *
+ * @details Each channel of the recording is bound to a VirtualPinAdapter, an EncoderAdapter
+ * (eg VirtualEncoderAdapter), a VirtualAnalogAdapter or a function. While it exists, the InputReplay is the InputClock
+ * source: simulated time starts at 0 and run() jumps it straight to the next sample or the next
+ * deadline of the registered inputs (see InputRegistry::nextDeadlineMs()), whichever is sooner.
+ * Create the InputReplay before calling begin() on the inputs so they also start at 0.
+ *
+ * Events are taken from the inputs with an EventQueue (set on the registry for the run, so callbacks
+ * are not called) and can be written to a Print as <code>ms,inputId,type,payload</code> lines. Save
+ * that output as a golden file and pass it to setGolden() to compare later runs against it.
+ *
+ * Only one InputReplay should exist at a time.
+ *
+ * ```cpp
+ * InputReplay replay;
+ * VirtualPinAdapter pin;
+ * EventButton button(&pin, true);
+ *
+ * replay.bindPin(0, &pin);
+ * button.begin();
+ * CsvReplaySource recording(file);
+ * ReplayResult result = replay.run(recording);
+ * ```
+ */
+class InputReplay {
+
+    public:
+
+    /**
+     * @brief The type of a function that receives the samples of a channel, eg to set an analog value.
+     */
+    typedef void (*SampleFunction)(uint8_t channel, int32_t value);
+
+    /**
+     * @brief Set InputClock to the simulated time (starting at 0).
+     */
+    InputReplay();
+
+    /**
+     * @brief Set InputClock back to <code>millis()</code> and <code>micros()</code>.
+     */
+    ~InputReplay();
+
+    InputReplay(const InputReplay&) = delete; // Owns the clock
+
+    /**
+     * @brief Set the pin state from the samples of a channel (0 is LOW, anything else HIGH).
+     *
+     * @return false if the channel is out of range
+     */
+    bool bindPin(uint8_t channel, VirtualPinAdapter* pin);
+
+    /**
+     * @brief Set the analog value from the samples of a channel.
+     *
+     * @return false if the channel is out of range
+     */
+    bool bindAnalog(uint8_t channel, VirtualAnalogAdapter* analog);
+
+    #ifndef EXCLUDE_EVENT_ENCODER
+    /**
+     * @brief Set the encoder position (in counts) from the samples of a channel.
+     *
+     * @return false if the channel is out of range
+     */
+    bool bindEncoder(uint8_t channel, EncoderAdapter* encoder);
+    #endif
+
+    /**
+     * @brief Pass the samples of a channel to a function.
+     *
+     * @return false if the channel is out of range
+     */
+    bool bindFunction(uint8_t channel, SampleFunction function);
+
+    /**
+     * @brief Also update the inputs at least every intervalMs, as loop() would.
+     * 
+     * @details 0 (the default) only updates at samples and deadlines (including pending debounces, see 
+     * DebounceAdapter::msUntilSettled()). Debouncers that cannot report when they settle, and encoder 
+     * changes rate limited to the next millisecond, are then only seen at the next sample. Set 1 to 
+     * model a tight loop().
+     */
+    void setPollInterval(uint16_t intervalMs) { pollMs = intervalMs; }
+
+    /**
+     * @brief How long to keep running after the last sample so pending clicks etc are fired. Default is 2000ms.
+     */
+    void setSettleTime(uint32_t ms) { settleMs = ms; }
+
+    /**
+     * @brief Write each event as a <code>ms,inputId,type,payload</code> line. Pass nullptr to stop.
+     */
+    void setEventLog(Print* out) { eventLog = out; }
+
+    /**
+     * @brief Compare each event with the next line of a golden file written by setEventLog(). Pass nullptr to stop.
+     * @details The stream must return all its data without waiting, eg an SD card File.
+     */
+    void setGolden(Stream* in) { golden = in; }
+
+    /**
+     * @brief Replay all the samples of a source.
+     *
+     * @details Simulated time carries on from the end of any previous run.
+     */
+    ReplayResult run(ReplaySource& source);
+
+    /**
+     * @brief Read a line of comma separated integers, skipping blank and <code>#</code> comment lines.
+     *
+     * @details Missing values are set to 0. Values wrap at 32 bits, so times larger than 32 bits keep their differences.
+     *
+     * @param in The stream
+     * @param values Where to put the values
+     * @param count The number of values to read
+     * @return false at the end of the stream
+     */
+    static bool readCsvLine(Stream& in, int32_t* values, uint8_t count);
+
+    private:
+
+    enum class ChannelType : uint8_t { NONE, PIN, ANALOG, ENCODER, FUNCTION };
+
+    struct Binding {
+        ChannelType type = ChannelType::NONE;
+        union {
+            VirtualPinAdapter* pin;
+            VirtualAnalogAdapter* analog;
+            #ifndef EXCLUDE_EVENT_ENCODER
+            EncoderAdapter* encoder;
+            #endif
+            SampleFunction function;
+        };
+        Binding() : pin(nullptr) {}
+    };
+
+    Binding bindings[INPUT_EVENTS_REPLAY_CHANNELS];
+    EventQueue queue;
+    Print* eventLog = nullptr;
+    Stream* golden = nullptr;
+    uint32_t settleMs = 2000;
+    uint16_t pollMs = 0;
+
+    static uint32_t simulatedMs;
+    static uint32_t simulatedUs;
+    static uint16_t usRemainder;
+    static uint32_t clockMs() { return simulatedMs; }
+    static uint32_t clockUs() { return simulatedUs; }
+
+    void apply(const ReplaySample& sample, ReplayResult& result);
+    void advance(uint32_t us);
+    void advanceTo(uint32_t targetUs, ReplayResult& result);
+    void step(ReplayResult& result);
+    void check(const InputEvent& e, ReplayResult& result);
+
+};
+
+#endif
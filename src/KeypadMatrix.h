@@ -0,0 +1,195 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef KEYPAD_MATRIX_H
+#define KEYPAD_MATRIX_H
+
+#include <Arduino.h>
+
+/**
+ * @brief The interface to a key matrix (up to 8 rows by 8 columns) scanned by an EventKeypad.
+ */
+class KeypadMatrix {
+
+    public:
+
+    virtual ~KeypadMatrix() {}
+
+    /**
+     * @brief Initialise the matrix (eg set the pin modes). Called from EventKeypad::begin().
+     */
+    virtual void begin() {}
+
+    /**
+     * @brief The number of rows (1-8).
+     */
+    virtual uint8_t rows() = 0;
+
+    /**
+     * @brief The number of columns (1-8).
+     */
+    virtual uint8_t cols() = 0;
+
+    /**
+     * @brief Read one row.
+     *
+     * @param row The row (from 0)
+     * @return uint8_t A bit for each column (bit 0 is column 0), set if the key is pressed
+     */
+    virtual uint8_t readRow(uint8_t row) = 0;
+
+};
+
+/**
+ * @brief A key matrix wired to GPIO pins. The columns use <code>INPUT_PULLUP</code> and each row is pulled
+ * <code>LOW</code> in turn while its columns are read.
+ *
+ * @details Rows that are not being read are left as <code>INPUT</code> (high impedance), so pressing several
+ * keys cannot short two rows together. Add diodes to the keys if three or more keys may be pressed at once
+ * (to prevent 'ghost' keys) or use EventKeypad::enableGhostBlocking().
+ */
+class GpioKeypadMatrix : public KeypadMatrix {
+
+    public:
+
+    /**
+     * @brief Construct a GpioKeypadMatrix.
+     *
+     * @param rowPins The row pins (must remain valid for the life of the matrix)
+     * @param rowCount The number of rows (1-8)
+     * @param colPins The column pins (must remain valid for the life of the matrix)
+     * @param colCount The number of columns (1-8)
+     */
+    GpioKeypadMatrix(const uint8_t* rowPins, uint8_t rowCount, const uint8_t* colPins, uint8_t colCount)
+    : rowPins(rowPins),
+      colPins(colPins),
+      rowCount(min(rowCount, (uint8_t)8)),
+      colCount(min(colCount, (uint8_t)8))
+    { }
+
+    void begin() override {
+        for ( uint8_t r = 0; r < rowCount; r++ ) {
+            pinMode(rowPins[r], INPUT);
+        }
+        for ( uint8_t c = 0; c < colCount; c++ ) {
+            pinMode(colPins[c], INPUT_PULLUP);
+        }
+    }
+
+    uint8_t rows() override { return rowCount; }
+
+    uint8_t cols() override { return colCount; }
+
+    uint8_t readRow(uint8_t row) override {
+        uint8_t pressed = 0;
+        pinMode(rowPins[row], OUTPUT);
+        digitalWrite(rowPins[row], LOW);
+        for ( uint8_t c = 0; c < colCount; c++ ) {
+            if ( digitalRead(colPins[c]) == LOW ) pressed |= (uint8_t)(1 << c);
+        }
+        pinMode(rowPins[row], INPUT);
+        return pressed;
+    }
+
+    private:
+    const uint8_t* rowPins;
+    const uint8_t* colPins;
+    uint8_t rowCount;
+    uint8_t colCount;
+
+};
+
+/**
+ * @brief A key matrix whose keys are pressed programmatically, eg by a test, benchmark or InputReplay.
+ */
+class VirtualKeypadMatrix : public KeypadMatrix {
+
+    public:
+
+    /**
+     * @brief Construct a VirtualKeypadMatrix with all keys released.
+     *
+     * @param rowCount The number of rows (1-8)
+     * @param colCount The number of columns (1-8)
+     */
+    VirtualKeypadMatrix(uint8_t rowCount = 4, uint8_t colCount = 4)
+    : rowCount(min(rowCount, (uint8_t)8)),
+      colCount(min(colCount, (uint8_t)8))
+    { }
+
+    uint8_t rows() override { return rowCount; }
+
+    uint8_t cols() override { return colCount; }
+
+    uint8_t readRow(uint8_t row) override {
+        rowReads++;
+        if ( !ghosting ) return rowState[row];
+        // Without diodes the row reaches every column connected to it through pressed keys
+        uint8_t reached = rowState[row];
+        uint8_t rowsReached = (uint8_t)(1 << row);
+        for ( bool grew = true; grew; ) {
+            grew = false;
+            for ( uint8_t r = 0; r < rowCount; r++ ) {
+                if ( !(rowsReached & (1 << r)) && (rowState[r] & reached) ) {
+                    rowsReached |= (uint8_t)(1 << r);
+                    reached |= rowState[r];
+                    grew = true;
+                }
+            }
+        }
+        return reached;
+    }
+
+    /**
+     * @brief Press a key.
+     */
+    void press(uint8_t row, uint8_t col) { setKey(row, col, true); }
+
+    /**
+     * @brief Release a key.
+     */
+    void release(uint8_t row, uint8_t col) { setKey(row, col, false); }
+
+    /**
+     * @brief Press or release a key.
+     */
+    void setKey(uint8_t row, uint8_t col, bool pressed) {
+        if ( row >= rowCount || col >= colCount ) return;
+        if ( pressed ) {
+            rowState[row] |= (uint8_t)(1 << col);
+        } else {
+            rowState[row] &= (uint8_t)~(1 << col);
+        }
+    }
+
+    /**
+     * @brief Press or release a key by its index (<code>row * cols() + col</code>), eg from an InputReplay function.
+     */
+    void setKey(uint8_t key, bool pressed) { setKey(key / colCount, key % colCount, pressed); }
+
+    /**
+     * @brief Read the keys as a matrix without diodes would, with 'ghost' keys (false by default).
+     * @details Pressing three keys at the corners of a rectangle then also reads the fourth as pressed.
+     */
+    void enableGhosting(bool ghost = true) { ghosting = ghost; }
+
+    /**
+     * @brief The number of times readRow() has been called.
+     */
+    uint32_t readCount() { return rowReads; }
+
+    private:
+    uint8_t rowCount;
+    uint8_t colCount;
+    uint8_t rowState[8] = {0};
+    uint32_t rowReads = 0;
+    bool ghosting = false;
+
+};
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef BankDebounceAdapter_h
+#define BankDebounceAdapter_h
+
+#include <Arduino.h>
+#include "PinAdapter.h"
+#include "../InputClock.h"
+
+template <class MaskT, uint8_t PinCount> class BasicBankDebounceAdapter;
+
+/**
+ * @brief A PinAdapter for one debounced pin of a BasicBankDebounceAdapter. Get one with BasicBankDebounceAdapter::pin().
+ *
+ */
+template <class MaskT, uint8_t PinCount = sizeof(MaskT) * 8>
+class BankPinAdapter final : public PinAdapter {
+
+    public:
+    /**
+     * @brief Initialises the bank (once for all its pins).
+     */
+    void begin() {
+        bank->begin();
+    }
+
+    /**
+     * @brief Returns the debounced state of the pin, sampling the bank once per scan if its sample interval has passed.
+     */
+    bool read() {
+        return bank->read(*this);
+    }
+
+    private:
+    friend class BasicBankDebounceAdapter<MaskT, PinCount>;
+    BasicBankDebounceAdapter<MaskT, PinCount>* bank = nullptr;
+    uint8_t bit = 0;
+    uint8_t seen = 0; // The scan this pin last read in
+
+};
+
+/**
+ * @brief Debounces a bank of up to 8, 16, 32 or 64 pins at once with vertical counters.
+ *
+ * @details Each pin has a two bit counter, held as one bit in each of two masks, so a sample of every pin is
+ * debounced with a handful of bitwise operations. A pin changes state once it has differed from its debounced
+ * state for four samples in a row. With the default 3ms sample interval that is 9-12ms.
+ *
+ * The raw pins are read either from an array of PinAdapters (bit n is pin n) or, faster, from a function that
+ * returns all the pins as a mask (eg from a port register). Pass the PinAdapter from pin(n) to an EventButton or
+ * EventSwitch *without* a debouncer:
+ *
+ * ```cpp
+ * PinAdapter* rawPins[] = { &pinA, &pinB, &pinC };
+ * BasicBankDebounceAdapter<uint8_t, 3> bank(rawPins, 3);
+ * EventButton buttonA(bank.pin(0), false);
+ * ```
+ *
+ * The bank is sampled (if the sample interval has passed) when a pin reads again, ie once per update() of the
+ * inputs, or by calling update().
+ *
+ * @tparam MaskT uint8_t, uint16_t, uint32_t or uint64_t
+ * @tparam PinCount The number of pins, default every bit of MaskT. Each pin has a PinAdapter, so set this for a
+ * bank with fewer pins than bits.
+ */
+template <class MaskT, uint8_t PinCount = sizeof(MaskT) * 8>
+class BasicBankDebounceAdapter {
+
+    static_assert(PinCount > 0 && PinCount <= sizeof(MaskT) * 8, "PinCount must be 1 to the number of bits in MaskT");
+
+    public:
+
+    /**
+     * @brief The type of a function that reads all the raw pins of the bank as a mask.
+     */
+    typedef MaskT (*ReadFunction)();
+
+    /**
+     * @brief The number of pins in the bank.
+     */
+    static const uint8_t PINS = PinCount;
+
+    /**
+     * @brief Construct a bank from an array of raw PinAdapters.
+     *
+     * @param rawPins The pins (bit n is rawPins[n]). The array must remain valid for the life of the bank.
+     * @param count The number of pins (up to PINS)
+     * @param sampleIntervalMs The time between samples, default 3ms
+     */
+    BasicBankDebounceAdapter(PinAdapter** rawPins, uint8_t count, uint16_t sampleIntervalMs = 3)
+    : rawPins(rawPins),
+      pinCount(count < PINS ? count : PINS),
+      sampleMs(sampleIntervalMs)
+    {
+        initPins();
+    }
+
+    /**
+     * @brief Construct a bank from a function that reads all the raw pins at once.
+     *
+     * @param readFunction Returns the raw pin states as a mask
+     * @param sampleIntervalMs The time between samples, default 3ms
+     */
+    BasicBankDebounceAdapter(ReadFunction readFunction, uint16_t sampleIntervalMs = 3)
+    : readFunction(readFunction),
+      pinCount(PINS),
+      sampleMs(sampleIntervalMs)
+    {
+        initPins();
+    }
+
+    /// \cond DO_NOT_DOCUMENT
+    BasicBankDebounceAdapter(const BasicBankDebounceAdapter&) = delete; // The pins point to the bank
+    BasicBankDebounceAdapter& operator=(const BasicBankDebounceAdapter&) = delete;
+    /// \endcond
+
+    /**
+     * @brief Initialise the raw pins and set the debounced state to their current state. Only the first call has any effect.
+     */
+    void begin() {
+        if ( begun ) return;
+        begun = true;
+        for ( uint8_t i = 0; rawPins && i < pinCount; i++ ) {
+            rawPins[i]->begin();
+        }
+        state = readRaw();
+        count0 = count1 = 0;
+        lastSampleMs = InputClock::ms();
+    }
+
+    /**
+     * @brief Sample the raw pins if the sample interval has passed.
+     */
+    void update(uint32_t nowMs) {
+        if ( (uint32_t)(nowMs - lastSampleMs) >= sampleMs ) {
+            lastSampleMs = nowMs;
+            sample(readRaw());
+        }
+    }
+
+    /**
+     * @brief Sample the raw pins if the sample interval has passed.
+     */
+    void update() { update(InputClock::ms()); }
+
+    /**
+     * @brief Debounce one sample of the raw pins (eg read elsewhere). Returns the debounced state.
+     */
+    MaskT sample(MaskT raw) {
+        // Count (0-3) the samples each pin has differed from its state, reset where it does not
+        MaskT delta = raw ^ state;
+        count1 = (count1 ^ count0) & delta;
+        count0 = ~count0 & delta;
+        // Toggle the pins whose count has wrapped, ie four differing samples in a row
+        state ^= delta & ~(count0 | count1);
+        return state;
+    }
+
+    /**
+     * @brief The debounced state of all the pins.
+     */
+    MaskT debounced() { return state; }
+
+    /**
+     * @brief The debounced state of one pin (sampling first if the sample interval has passed).
+     */
+    bool read(uint8_t bit) {
+        update(InputClock::ms());
+        return (state >> bit) & 1;
+    }
+
+    /**
+     * @brief The debounced state of a pin. A pin that reads again starts a new scan, so the clock is read 
+     * (and the bank sampled if the sample interval has passed) once per scan rather than once per pin.
+     */
+    bool read(BankPinAdapter<MaskT, PinCount>& p) {
+        if ( p.seen == scan ) {
+            update(InputClock::ms());
+            scan++;
+        }
+        p.seen = scan;
+        return (state >> p.bit) & 1;
+    }
+
+    /**
+     * @brief The PinAdapter for one pin of the bank.
+     *
+     * @param bit The pin (0 to PINS - 1)
+     * @return PinAdapter* nullptr if out of range
+     */
+    PinAdapter* pin(uint8_t bit) { return bit < PINS ? &pins[bit] : nullptr; }
+
+    /**
+     * @brief Set the time between samples. A pin changes after four samples, so the debounce time is 3-4 times this.
+     *
+     * @param intervalMs Default is 3ms
+     */
+    void setSampleInterval(uint16_t intervalMs = 3) { sampleMs = intervalMs; }
+
+    private:
+
+    void initPins() {
+        for ( uint8_t i = 0; i < PINS; i++ ) {
+            pins[i].bank = this;
+            pins[i].bit = i;
+        }
+    }
+
+    MaskT readRaw() {
+        if ( readFunction ) return readFunction();
+        MaskT raw = 0;
+        for ( uint8_t i = 0; i < pinCount; i++ ) {
+            if ( rawPins[i]->read() ) raw |= (MaskT)1 << i;
+        }
+        return raw;
+    }
+
+    PinAdapter** rawPins = nullptr;
+    ReadFunction readFunction = nullptr;
+    uint8_t pinCount;
+    bool begun = false;
+    uint16_t sampleMs;
+    uint8_t scan = 0;
+    uint32_t lastSampleMs = 0;
+    MaskT state = 0;
+    MaskT count0 = 0;
+    MaskT count1 = 0;
+    BankPinAdapter<MaskT, PinCount> pins[PINS];
+
+};
+
+/**
+ * @brief A BasicBankDebounceAdapter for up to 8 pins.
+ */
+typedef BasicBankDebounceAdapter<uint8_t> BankDebounceAdapter8;
+
+/**
+ * @brief A BasicBankDebounceAdapter for up to 16 pins.
+ */
+typedef BasicBankDebounceAdapter<uint16_t> BankDebounceAdapter16;
+
+/**
+ * @brief A BasicBankDebounceAdapter for up to 32 pins.
+ */
+typedef BasicBankDebounceAdapter<uint32_t> BankDebounceAdapter;
+
+/**
+ * @brief A BasicBankDebounceAdapter for up to 64 pins.
+ */
+typedef BasicBankDebounceAdapter<uint64_t> BankDebounceAdapter64;
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "Arduino.h"
 #include "PinAdapter.h"
+#include "../InputEvents.h"
 
 /**
  * @brief This is the interface/base class for debounce adapters
@@ -36,6 +37,53 @@ class DebounceAdapter : public PinAdapter {
      */
     virtual bool read() = 0;
 
+    /**
+     * @brief Return the debounced state of the pin adapter using a time already sampled from InputClock::ms().
+     * @details Called by update(nowMs). The default implementation returns read() and, as it cannot know 
+     * when the edge was, reports nowMs from changedAtMs().
+     * 
+     * @param nowMs The current time in milliseconds
+     * @return The debounced state
+     */
+    virtual bool read(uint32_t nowMs) { 
+        changedAt = nowMs;
+        return read(); 
+    }
+
+    /**
+     * @brief Debounce a pin state sampled at a known time rather than reading the pin adapter.
+     * @details Used when edges are captured by an interrupt so debouncing runs on the time of 
+     * the edge rather than the time it was polled. Samples must be passed in time order.
+     * 
+     * The default implementation ignores the sample and returns read() so existing debouncers 
+     * still work (without the benefit of the edge times).
+     * 
+     * @param pinState The pin state
+     * @param ms The millis() when the pin was in this state
+     * @return The debounced state
+     */
+    virtual bool debounce(bool /*pinState*/, uint32_t ms) {
+        changedAt = ms;
+        return read();
+    }
+
+    /**
+     * @brief The time (in millis()) of the pin edge that caused the last change of debounced state.
+     * @details Only valid after debounce() or read(nowMs) has been called. Debouncers that do not 
+     * track edges report the time of the call.
+     */
+    uint32_t changedAtMs() { return changedAt; }
+
+    /**
+     * @brief The number of milliseconds until a pending change of state will be accepted (if the pin holds).
+     * @details Lets inputs include the debounce in their nextDeadlineMs(). The default, for debouncers 
+     * that cannot tell, is NO_DEADLINE.
+     * 
+     * @param nowMs The current time in milliseconds
+     * @return 0 if due now, NO_DEADLINE if no change is pending
+     */
+    virtual uint32_t msUntilSettled(uint32_t /*nowMs*/) { return NO_DEADLINE; }
+
     /**
      * @brief The pinAdapter is usually passed via the constructor. 
      * If it is not, it must be set before begin() is called.
@@ -58,6 +106,7 @@ class DebounceAdapter : public PinAdapter {
     protected:
     PinAdapter* pinAdapter;
     uint16_t debounceInterval = 10;   
+    uint32_t changedAt = 0; ///< Time of the edge that caused the last debounced change
 };
 
 #endif
@@ -0,0 +1,89 @@
+#ifndef EdgeBuffer_h
+#define EdgeBuffer_h
+
+#include <Arduino.h>
+#include "PinAdapter.h"
+
+#ifndef INPUT_EVENTS_EDGE_BUFFER_SIZE
+/**
+ * @brief The number of edges an EdgeBuffer can hold. Must be a power of two, no more than 128.
+ * @details Can be overridden with a build flag. One slot is always kept free.
+ */
+#define INPUT_EVENTS_EDGE_BUFFER_SIZE 16
+#endif
+
+/**
+ * @brief A lock-free single producer, single consumer ring of PinEdges.
+ * 
+ * @details The producer (normally an interrupt service routine) calls push() and the consumer 
+ * (normally update()) calls pop(). No interrupts are disabled - each side only ever writes its 
+ * own index and the indexes are single bytes published with release/acquire ordering, so the 
+ * producer can equally be a thread on a host build.
+ * 
+ * If the buffer is full, new edges are dropped and counted.
+ */
+class EdgeBuffer {
+
+    static_assert((INPUT_EVENTS_EDGE_BUFFER_SIZE & (INPUT_EVENTS_EDGE_BUFFER_SIZE - 1)) == 0 
+                    && INPUT_EVENTS_EDGE_BUFFER_SIZE <= 128, 
+                  "INPUT_EVENTS_EDGE_BUFFER_SIZE must be a power of two, no more than 128");
+
+    public:
+
+    /**
+     * @brief Add an edge. Only call from the producer (eg the ISR).
+     * 
+     * @return true If the edge was added
+     * @return false If the buffer was full (the edge is dropped)
+     */
+    bool push(bool state, uint32_t ms, uint32_t us) {
+        uint8_t h = __atomic_load_n(&head, __ATOMIC_RELAXED);
+        uint8_t next = (h + 1) & MASK;
+        if ( next == __atomic_load_n(&tail, __ATOMIC_ACQUIRE) ) {
+            dropped++;
+            return false;
+        }
+        edges[h].ms = ms;
+        edges[h].us = us;
+        edges[h].state = state;
+        __atomic_store_n(&head, next, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest edge. Only call from the consumer (eg update()).
+     * 
+     * @return true If an edge was returned
+     * @return false If the buffer is empty
+     */
+    bool pop(PinEdge& edge) {
+        uint8_t t = __atomic_load_n(&tail, __ATOMIC_RELAXED);
+        if ( t == __atomic_load_n(&head, __ATOMIC_ACQUIRE) ) return false;
+        edge.ms = edges[t].ms;
+        edge.us = edges[t].us;
+        edge.state = edges[t].state;
+        __atomic_store_n(&tail, (uint8_t)((t + 1) & MASK), __ATOMIC_RELEASE);
+        return true;
+    }
+
+    /**
+     * @brief Returns true if there are no edges waiting.
+     */
+    bool isEmpty() { return __atomic_load_n(&tail, __ATOMIC_ACQUIRE) == __atomic_load_n(&head, __ATOMIC_ACQUIRE); }
+
+    /**
+     * @brief The number of edges dropped because the buffer was full.
+     */
+    uint16_t droppedCount() { return dropped; }
+
+    private:
+
+    static const uint8_t MASK = INPUT_EVENTS_EDGE_BUFFER_SIZE - 1;
+    PinEdge edges[INPUT_EVENTS_EDGE_BUFFER_SIZE];
+    uint8_t head = 0; // Written by the producer only
+    uint8_t tail = 0; // Written by the consumer only
+    volatile uint16_t dropped = 0;
+
+};
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef ExpanderInputBank_h
+#define ExpanderInputBank_h
+
+#include <Arduino.h>
+#include "PortSnapshot.h"
+#include "../InputClock.h"
+
+/**
+ * @brief The bus of an I/O expander (eg MCP23017, PCF8574), read in one transaction.
+ *
+ * @details See WireExpanderBus.h for Mcp23017Bus and Pcf8574Bus, or use VirtualExpanderBus to simulate an expander.
+ */
+class ExpanderBus {
+
+    public:
+
+    virtual ~ExpanderBus() {}
+
+    /**
+     * @brief Configure the expander's pins as inputs.
+     */
+    virtual void begin() {}
+
+    /**
+     * @brief Read every input of the expander in one bus transaction (which also clears its interrupt).
+     */
+    virtual uint16_t readAll() = 0;
+};
+
+/**
+ * @brief A simulated expander, eg for tests or with an InputReplay.
+ *
+ * @details As a real expander, its interrupt line (from interruptPin()) goes LOW when an input changes and
+ * is cleared by readAll().
+ */
+class VirtualExpanderBus : public ExpanderBus {
+
+    public:
+
+    VirtualExpanderBus() {}
+
+    /// \cond DO_NOT_DOCUMENT
+    VirtualExpanderBus(const VirtualExpanderBus&) = delete; // The interrupt line points to the bus
+    VirtualExpanderBus& operator=(const VirtualExpanderBus&) = delete;
+    /// \endcond
+
+    /**
+     * @brief Read the inputs (and clear the interrupt).
+     */
+    uint16_t readAll() override {
+        pending = false;
+        reads++;
+        return inputs;
+    }
+
+    /**
+     * @brief Set the level of one input.
+     */
+    void setInput(uint8_t input, bool level) {
+        if ( input >= 16 ) return;
+        uint16_t bit = (uint16_t)1 << input;
+        setInputs(level ? (inputs | bit) : (inputs & ~bit));
+    }
+
+    /**
+     * @brief Set the levels of all the inputs. The interrupt is asserted if any have changed.
+     */
+    void setInputs(uint16_t levels) {
+        if ( levels != inputs ) pending = true;
+        inputs = levels;
+    }
+
+    /**
+     * @brief The levels of the inputs.
+     */
+    uint16_t getInputs() { return inputs; }
+
+    /**
+     * @brief The expander's interrupt line, LOW while a change has not been read.
+     */
+    PinAdapter* interruptPin() { return &intPin; }
+
+    /**
+     * @brief The number of bus reads.
+     */
+    uint32_t readCount() { return reads; }
+
+    private:
+
+    class InterruptLine final : public PinAdapter {
+        public:
+        InterruptLine(VirtualExpanderBus* bus) : bus(bus) {}
+        void begin() {}
+        bool read() { return !bus->pending; }
+        private:
+        VirtualExpanderBus* bus;
+    };
+
+    uint16_t inputs = 0xFFFF; // Pulled up
+    bool pending = false;
+    uint32_t reads = 0;
+    InterruptLine intPin{this};
+};
+
+/**
+ * @brief Reads all the inputs of an I/O expander in one bus transaction, only when they may have changed, and
+ * gives out a PinAdapter for each input.
+ *
+ * @details Reading each button from an I2C expander separately takes a bus transaction per button. This is a
+ * BasicPortSnapshot of the expander, so all its inputs are read at most once per scan. With the expander's
+ * interrupt line (active LOW, as the MCP23017 and PCF8574) the bus is only read when it is asserted, or if
+ * the timeout has passed in case an interrupt was missed. Without it, the bus is read every read interval.
+ *
+ * ```cpp
+ * Mcp23017Bus mcp(0x20);
+ * GpioPinAdapter mcpInt(2); // INTA
+ * ExpanderInputBank expander(&mcp, &mcpInt);
+ * EventButton button(expander.pin(0)); // GPA0
+ * ```
+ *
+ * @tparam MaskT uint8_t or uint16_t
+ */
+template <class MaskT>
+class BasicExpanderInputBank : public BasicPortSnapshot<MaskT, BasicExpanderInputBank<MaskT>> {
+
+    typedef BasicPortSnapshot<MaskT, BasicExpanderInputBank> Snapshot;
+
+    public:
+
+    /**
+     * @brief Construct a bank that polls the expander.
+     *
+     * @param bus The expander's bus
+     * @param readIntervalMs The time between bus reads, default 5ms
+     */
+    BasicExpanderInputBank(ExpanderBus* bus, uint16_t readIntervalMs = 5)
+    : bus(bus), readIntervalMs(readIntervalMs)
+    {}
+
+    /**
+     * @brief Construct a bank that reads the expander when its interrupt line is asserted (LOW).
+     *
+     * @param bus The expander's bus
+     * @param interruptPin The expander's interrupt line
+     * @param timeoutMs Read the bus anyway if this long has passed since the last read, default 100ms
+     */
+    BasicExpanderInputBank(ExpanderBus* bus, PinAdapter* interruptPin, uint16_t timeoutMs = 100)
+    : bus(bus), interruptPin(interruptPin), readIntervalMs(timeoutMs)
+    {}
+
+    /**
+     * @brief Configure the expander and interrupt pin and take the first snapshot. Call from <code>setup()</code>.
+     */
+    void begin() {
+        bus->begin();
+        if ( interruptPin ) interruptPin->begin();
+        forceRead = true;
+        this->refresh();
+    }
+
+    /**
+     * @brief Set the time between bus reads (or, with an interrupt line, the timeout).
+     */
+    void setReadInterval(uint16_t intervalMs) { readIntervalMs = intervalMs; }
+
+    /**
+     * @brief The number of bus reads (eg to check a test only reads on an interrupt).
+     */
+    uint32_t busReadCount() { return busReads; }
+
+    protected:
+
+    friend class BasicPortSnapshot<MaskT, BasicExpanderInputBank>;
+
+    /**
+     * @brief Read the bus if it is due (or the interrupt is asserted), otherwise keep the last snapshot. Called by refresh().
+     */
+    MaskT readSnapshot() {
+        uint32_t nowMs = InputClock::ms();
+        bool due = forceRead || (uint32_t)(nowMs - lastReadMs) >= readIntervalMs;
+        if ( interruptPin && interruptPin->read() == LOW ) due = true;
+        if ( !due ) return this->value();
+        forceRead = false;
+        lastReadMs = nowMs;
+        busReads++;
+        return (MaskT)bus->readAll();
+    }
+
+    private:
+    ExpanderBus* bus;
+    PinAdapter* interruptPin = nullptr;
+    uint16_t readIntervalMs;
+    uint32_t lastReadMs = 0;
+    uint32_t busReads = 0;
+    bool forceRead = true;
+
+};
+
+/**
+ * @brief A BasicExpanderInputBank for an 8 bit expander (eg PCF8574, MCP23008).
+ */
+typedef BasicExpanderInputBank<uint8_t> ExpanderInputBank8;
+
+/**
+ * @brief A BasicExpanderInputBank for a 16 bit expander (eg MCP23017, PCF8575).
+ */
+typedef BasicExpanderInputBank<uint16_t> ExpanderInputBank;
+
+#endif
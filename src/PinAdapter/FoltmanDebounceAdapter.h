@@ -3,6 +3,7 @@
 
 #include "Arduino.h"
 #include "DebounceAdapter.h"
+#include "../InputClock.h"
 
 /**
  * @brief This is the default InputEvents debouncer. Many thanks to @kfoltman.
@@ -16,33 +17,47 @@ class FoltmanDebounceAdapter : public DebounceAdapter {
 
     void begin() {
         DebounceAdapter::begin();
-        lastChangeMs = millis();
+        lastChangeMs = InputClock::ms();
         nextState = lastState = pinAdapter->read();
     }
 
     bool read() override {
-        bool newState = pinAdapter->read();
+        return read(InputClock::ms());
+    }
+
+    bool read(uint32_t nowMs) override {
+        return debounce(pinAdapter->read(), nowMs);
+    }
+
+    bool debounce(bool newState, uint32_t ms) override {
         if (nextState == lastState) {
             // Steady state so far
             if (newState != nextState) {
                 // Initiating state change
                 nextState = newState;
-                lastChangeMs = millis();
+                lastChangeMs = ms;
             }
         } else {
             // Change pending
             if (newState != nextState) {
                 // Glitch: reset the counter
                 nextState = lastState;
-                lastChangeMs = millis();
-            } else if (millis() - lastChangeMs >= debounceInterval) {
+                lastChangeMs = ms;
+            } else if (ms - lastChangeMs >= debounceInterval) {
                 // Got debounceInterval ms of glitchless signal
                 lastState = newState;
+                changedAt = lastChangeMs;
             }
         }
         return lastState;
     }
 
+    uint32_t msUntilSettled(uint32_t nowMs) override {
+        if ( nextState == lastState ) return NO_DEADLINE;
+        uint32_t elapsed = nowMs - lastChangeMs;
+        return elapsed >= debounceInterval ? 0 : debounceInterval - elapsed;
+    }
+
     private:
     uint32_t lastChangeMs;
     bool lastState, nextState;
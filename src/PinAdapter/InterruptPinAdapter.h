@@ -0,0 +1,150 @@
+#ifndef InterruptPinAdapter_h
+#define InterruptPinAdapter_h
+
+#include <Arduino.h>
+#include "PinAdapter.h"
+#include "EdgeBuffer.h"
+#include "../InputClock.h"
+
+/**
+ * @brief A PinAdapter for GPIO pins that captures timestamped edges from a pin change interrupt.
+ * 
+ * @details When used with an EventButton or EventSwitch, edges are captured as they happen and
+ * processed by the next update(), so a short press is not missed and durations are timed from the 
+ * edges rather than from when update() was called.
+ * 
+ * Because interrupt service routines cannot take an argument on all boards, you provide a 
+ * small function that calls onInterrupt() and pass it to begin():
+ * 
+ * ```cpp
+ * InterruptPinAdapter buttonPin(2);
+ * EventButton myButton(&buttonPin);
+ * void buttonIsr() { buttonPin.onInterrupt(); }
+ * 
+ * void setup() {
+ *     buttonPin.attach(buttonIsr); // Before myButton.begin()
+ *     myButton.begin();
+ * }
+ * ```
+ * 
+ * On a host build (or for testing) edges can be injected with pushEdge() from another thread.
+ */
+class InterruptPinAdapter : public PinAdapter {
+
+    public:
+
+    /**
+     * @brief Construct an InterruptPinAdapter
+     * 
+     * @param pin The GPIO pin number. Must support interrupts (eg pins 2 or 3 on an UNO).
+     * @param mode Defaults to INPUT_PULLUP.
+     */
+    InterruptPinAdapter(byte pin, uint8_t mode = INPUT_PULLUP)
+    : buttonPin(pin),
+      _pinMode(mode)
+    { }
+
+    /**
+     * @brief Set the interrupt service routine. It must call onInterrupt(). 
+     * @details The interrupt is attached in begin(). If this is not set, edges are only
+     * captured if onInterrupt() or pushEdge() are called by other means.
+     * 
+     * @param isr A function that calls onInterrupt()
+     */
+    void attach(void (*isr)()) {
+        interruptHandler = isr;
+    }
+
+    void begin() {
+        pinMode(buttonPin, _pinMode);
+        delayMicroseconds(2000); // Allow any R-C filter to charge (see GpioPinAdapter)
+        lastState = digitalRead(buttonPin);
+        if ( interruptHandler ) {
+            attachInterrupt(digitalPinToInterrupt(buttonPin), interruptHandler, CHANGE);
+        }
+    }
+
+    /**
+     * @brief Returns the state of the most recent edge (even if it was dropped because the buffer was full).
+     */
+    bool read() {
+        return lastState;
+    }
+
+    bool capturesEdges() override { return true; }
+
+    /**
+     * @brief Remove the oldest captured edge. 
+     * @details If edges have been dropped, a final edge with the most recent state is
+     * returned (timed now) once the buffer is empty so the input is not left out of step with the pin.
+     */
+    bool popEdge(PinEdge& edge) override {
+        if ( !edges.pop(edge) ) {
+            uint16_t drops = edges.droppedCount();
+            if ( drops == resyncedDrops ) return false;
+            bool state = lastState;
+            // Edges pushed since the buffer was found empty must be popped before the resync or they would undo it
+            if ( !edges.pop(edge) ) {
+                resyncedDrops = drops;
+                edge.state = state;
+                edge.ms = InputClock::ms();
+                edge.us = InputClock::us();
+            }
+        }
+        popped = edge;
+        hasPopped = true;
+        return true;
+    }
+
+    bool lastEdge(PinEdge& edge) override {
+        edge = popped;
+        return hasPopped;
+    }
+
+    /**
+     * @brief Call this from your interrupt service routine.
+     */
+    void onInterrupt() {
+        bool state = digitalRead(buttonPin);
+        if ( state != lastState ) {
+            pushEdge(state, InputClock::ms(), InputClock::us());
+        }
+    }
+
+    /**
+     * @brief Add an edge. Called by onInterrupt() but can also be used to inject edges (eg from a test thread).
+     * 
+     * @param state The pin state after the edge
+     * @param ms The millis() of the edge
+     * @param us The micros() of the edge
+     */
+    void pushEdge(bool state, uint32_t ms, uint32_t us) {
+        lastState = state;
+        edges.push(state, ms, us);
+    }
+
+    /**
+     * @brief Add an edge with only a millisecond time (its micros() time is taken as ms * 1000).
+     */
+    void pushEdge(bool state, uint32_t ms) {
+        pushEdge(state, ms, ms * 1000UL);
+    }
+
+    /**
+     * @brief The number of edges dropped because update() was not called often enough.
+     */
+    uint16_t droppedCount() { return edges.droppedCount(); }
+
+    private:
+    byte buttonPin;
+    uint8_t _pinMode = INPUT_PULLUP;
+    void (*interruptHandler)() = nullptr;
+    volatile bool lastState = HIGH;
+    bool hasPopped = false;
+    uint16_t resyncedDrops = 0;
+    PinEdge popped = {0, 0, HIGH}; // The last edge returned by popEdge()
+    EdgeBuffer edges;
+
+};
+
+#endif
@@ -1,6 +1,18 @@
 #ifndef PinAdapter_h
 #define PinAdapter_h
 
+#include <stdint.h>
+
+/**
+ * @brief A timestamped change of pin state, captured by an interrupt.
+ * 
+ */
+struct PinEdge {
+    uint32_t ms; ///< millis() when the edge was captured
+    uint32_t us; ///< micros() when the edge was captured
+    bool state;  ///< The pin state after the edge
+};
+
 /**
  * @brief The interface specification for button, encoder button and switch pins.
  * 
@@ -20,6 +32,29 @@ class PinAdapter {
      */
     virtual bool read() = 0;
 
+    /**
+     * @brief Returns true if the adapter captures timestamped edges (eg from an interrupt).
+     * @details If true, EventButton and EventSwitch will process edges from popEdge() instead of polling read().
+     */
+    virtual bool capturesEdges() { return false; }
+
+    /**
+     * @brief Remove the oldest captured edge.
+     * 
+     * @param edge Set to the oldest edge if one is available
+     * @return true If an edge was returned
+     * @return false If no edges are waiting (always false unless capturesEdges() is true)
+     */
+    virtual bool popEdge(PinEdge& /*edge*/) { return false; }
+
+    /**
+     * @brief The edge most recently returned by popEdge(), so inputs need not keep their own copy.
+     * 
+     * @param edge Set to the last popped edge if there is one
+     * @return false If no edge has been popped yet (always false unless capturesEdges() is true)
+     */
+    virtual bool lastEdge(PinEdge& /*edge*/) { return false; }
+
     virtual ~PinAdapter() = default;
 };
 
@@ -0,0 +1,176 @@
+#ifndef PortSnapshot_h
+#define PortSnapshot_h
+
+#include <Arduino.h>
+#include "PinAdapter.h"
+
+template <class MaskT, class SourceT> class BasicPortSnapshot;
+
+/**
+ * @brief A PinAdapter for one bit of a BasicPortSnapshot. Get one with BasicPortSnapshot::pin().
+ *
+ */
+template <class MaskT, class SourceT = void>
+class PortPinAdapter final : public PinAdapter {
+
+    public:
+    /**
+     * @brief Does nothing - set the pin modes of the port in <code>setup()</code>.
+     */
+    void begin() {}
+
+    /**
+     * @brief Returns the bit from the snapshot, taking a new snapshot if this pin has already read the current one.
+     */
+    bool read() {
+        return snapshot->read(*this);
+    }
+
+    private:
+    friend class BasicPortSnapshot<MaskT, SourceT>;
+    BasicPortSnapshot<MaskT, SourceT>* snapshot = nullptr;
+    uint8_t bit = 0;
+    uint8_t seen = 0; // The snapshot this pin last read
+};
+
+/**
+ * @brief Reads a whole GPIO port (or any other bulk read) once per scan and gives out a PinAdapter for each bit.
+ *
+ * @details Reading a port register is a single load, where each <code>digitalRead()</code> has to look up the
+ * port and bit of its pin. The snapshot is taken from a port input register or from a function that returns
+ * all the bits (eg a test or a mock). Each pin from pin(n) only extracts its bit, so it can be passed to an
+ * EventButton, EventSwitch or debounce adapter in place of a GpioPinAdapter:
+ *
+ * ```cpp
+ * PortSnapshot8 portD(&PIND); // Arduino UNO pins 0-7
+ * EventButton button(portD.pin(2)); // Pin 2
+ * ```
+ *
+ * A new snapshot is taken when a pin reads again, ie once per update() of the inputs (or call refresh()).
+ * The pins do not set their pin mode - call <code>pinMode()</code> for them in <code>setup()</code>.
+ *
+ * Other sources (eg ShiftRegisterInputBank) derive from a BasicPortSnapshot with themselves as SourceT and
+ * implement <code>MaskT readSnapshot()</code>, which is called directly rather than through a virtual function.
+ *
+ * @tparam MaskT The width of the port, uint8_t, uint16_t or uint32_t
+ * @tparam SourceT The derived class that reads the bits with readSnapshot(), or void (the default) to read
+ * the port input register or read function
+ */
+template <class MaskT, class SourceT = void>
+class BasicPortSnapshot {
+
+    public:
+
+    /**
+     * @brief The type of a function that reads all the bits at once.
+     */
+    typedef MaskT (*ReadFunction)();
+
+    /**
+     * @brief The number of bits (and pins).
+     */
+    static const uint8_t PINS = sizeof(MaskT) * 8;
+
+    /**
+     * @brief Construct a snapshot of a port input register, eg <code>&PIND</code> on an AVR.
+     */
+    BasicPortSnapshot(volatile MaskT* inputRegister)
+    : inputRegister(inputRegister)
+    {
+        initPins();
+    }
+
+    /**
+     * @brief Construct a snapshot from a function that reads all the bits at once.
+     */
+    BasicPortSnapshot(ReadFunction readFunction)
+    : readFunction(readFunction)
+    {
+        initPins();
+    }
+
+    /// \cond DO_NOT_DOCUMENT
+    BasicPortSnapshot(const BasicPortSnapshot&) = delete; // The pins point to the snapshot
+    BasicPortSnapshot& operator=(const BasicPortSnapshot&) = delete;
+    /// \endcond
+
+    /**
+     * @brief Take a new snapshot now.
+     */
+    MaskT refresh() {
+        snapshot = readFrom(static_cast<SourceT*>(this));
+        generation++;
+        refreshes++;
+        return snapshot;
+    }
+
+    /**
+     * @brief The current snapshot.
+     */
+    MaskT value() { return snapshot; }
+
+    /**
+     * @brief The PinAdapter for one bit.
+     *
+     * @param bit The bit (0 to PINS - 1)
+     * @return PinAdapter* nullptr if out of range
+     */
+    PinAdapter* pin(uint8_t bit) { return bit < PINS ? &pins[bit] : nullptr; }
+
+    /**
+     * @brief The number of snapshots taken (eg to check a test reads the port once per scan).
+     */
+    uint32_t refreshCount() { return refreshes; }
+
+    /**
+     * @brief Read a bit for a pin. A pin that reads again starts a new scan, so the port is read once per scan.
+     */
+    bool read(PortPinAdapter<MaskT, SourceT>& p) {
+        if ( p.seen == generation ) refresh();
+        p.seen = generation;
+        return (snapshot >> p.bit) & 1;
+    }
+
+    protected:
+
+    /**
+     * @brief For snapshots of other sources (eg ShiftRegisterInputBank), which implement readSnapshot().
+     */
+    BasicPortSnapshot() {
+        initPins();
+    }
+
+    private:
+
+    template <class S>
+    MaskT readFrom(S* source) { return source->readSnapshot(); }
+
+    MaskT readFrom(void*) { return readFunction ? readFunction() : *inputRegister; }
+
+    void initPins() {
+        for ( uint8_t i = 0; i < PINS; i++ ) {
+            pins[i].snapshot = this;
+            pins[i].bit = i;
+        }
+    }
+
+    volatile MaskT* inputRegister = nullptr;
+    ReadFunction readFunction = nullptr;
+    MaskT snapshot = 0;
+    uint8_t generation = 0;
+    uint32_t refreshes = 0;
+    PortPinAdapter<MaskT, SourceT> pins[PINS];
+
+};
+
+/**
+ * @brief A BasicPortSnapshot of an 8 bit port (eg AVR).
+ */
+typedef BasicPortSnapshot<uint8_t> PortSnapshot8;
+
+/**
+ * @brief A BasicPortSnapshot of a 32 bit port (eg ESP32, SAMD, RP2040).
+ */
+typedef BasicPortSnapshot<uint32_t> PortSnapshot;
+
+#endif
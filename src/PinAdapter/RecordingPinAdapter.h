@@ -0,0 +1,70 @@
+#ifndef RecordingPinAdapter_h
+#define RecordingPinAdapter_h
+
+#include <Arduino.h>
+#include "PinAdapter.h"
+#include "../FlightRecorder.h"
+
+/**
+ * @brief Records the raw edges of another PinAdapter in a FlightRecorder.
+ * 
+ * @details Pass it to an input in place of the PinAdapter it wraps. Polled pins are recorded when 
+ * read() sees a change (the input's debouncer reads the raw pin, so every bounce is recorded). Pins 
+ * that capture edges (eg InterruptPinAdapter) are recorded with the time of the interrupt.
+ * 
+ * ```cpp
+ * FlightRecorder recorder;
+ * GpioPinAdapter gpio(2);
+ * RecordingPinAdapter pin(&gpio, &recorder, 0);
+ * EventButton button(&pin);
+ * ```
+ */
+class RecordingPinAdapter : public PinAdapter {
+
+    public:
+    /**
+     * @brief Construct a RecordingPinAdapter.
+     * 
+     * @param pin The PinAdapter to record
+     * @param recorder The FlightRecorder
+     * @param channel 0-63, recorded with each edge (eg the InputReplay channel for the pin)
+     */
+    RecordingPinAdapter(PinAdapter* pin, FlightRecorder* recorder, uint8_t channel)
+        : pin(pin), recorder(recorder), channel(channel)
+        { }
+
+    void begin() {
+        pin->begin();
+        state = pin->read();
+        recorder->recordEdge(channel, state); // The starting level
+    }
+
+    bool read() {
+        bool newState = pin->read();
+        if ( newState != state ) {
+            state = newState;
+            recorder->recordEdge(channel, state);
+        }
+        return newState;
+    }
+
+    bool capturesEdges() { return pin->capturesEdges(); }
+
+    bool popEdge(PinEdge& edge) {
+        if ( !pin->popEdge(edge) ) return false;
+        state = edge.state;
+        recorder->recordEdge(channel, edge.state, edge.us);
+        return true;
+    }
+
+    bool lastEdge(PinEdge& edge) { return pin->lastEdge(edge); }
+
+    private:
+    PinAdapter* pin;
+    FlightRecorder* recorder;
+    uint8_t channel;
+    bool state = HIGH;
+
+};
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef ShiftRegisterInputBank_h
+#define ShiftRegisterInputBank_h
+
+#include <Arduino.h>
+#include "PortSnapshot.h"
+
+/**
+ * @brief The load, clock and data lines of a chain of parallel-in serial-out shift registers (eg 74HC165, CD4021).
+ *
+ * @details Implemented by GpioShiftRegisterLines and VirtualShiftRegisterChain, or your own (eg to use SPI).
+ */
+class ShiftRegisterLines {
+
+    public:
+
+    virtual ~ShiftRegisterLines() {}
+
+    /**
+     * @brief Set the pin modes.
+     */
+    virtual void begin() {}
+
+    /**
+     * @brief Latch the parallel inputs of every register into the chain.
+     */
+    virtual void load() = 0;
+
+    /**
+     * @brief The serial data out of the chain, ie the bit currently at its end.
+     */
+    virtual bool data() = 0;
+
+    /**
+     * @brief Shift the chain along by one bit.
+     */
+    virtual void clock() = 0;
+};
+
+/**
+ * @brief ShiftRegisterLines on GPIO pins.
+ *
+ * @details For a 74HC165: the load pin is wired to SH/LD (PL), the clock pin to CLK (CP) and the data pin
+ * to QH (Q7) of the register nearest the Arduino. Tie CLK INH (CE) low.
+ */
+class GpioShiftRegisterLines : public ShiftRegisterLines {
+
+    public:
+
+    /**
+     * @brief Construct the lines from their pins.
+     *
+     * @param loadPin The parallel load pin, active LOW
+     * @param clockPin The clock pin, shifts on the rising edge
+     * @param dataPin The serial data out of the chain
+     */
+    GpioShiftRegisterLines(uint8_t loadPin, uint8_t clockPin, uint8_t dataPin)
+    : loadPin(loadPin), clockPin(clockPin), dataPin(dataPin) {}
+
+    void begin() override {
+        pinMode(loadPin, OUTPUT);
+        pinMode(clockPin, OUTPUT);
+        pinMode(dataPin, INPUT);
+        digitalWrite(loadPin, HIGH);
+        digitalWrite(clockPin, LOW);
+    }
+
+    void load() override {
+        digitalWrite(loadPin, LOW);
+        digitalWrite(loadPin, HIGH);
+    }
+
+    bool data() override {
+        return digitalRead(dataPin);
+    }
+
+    void clock() override {
+        digitalWrite(clockPin, HIGH);
+        digitalWrite(clockPin, LOW);
+    }
+
+    private:
+    uint8_t loadPin;
+    uint8_t clockPin;
+    uint8_t dataPin;
+};
+
+/**
+ * @brief A simulated chain of shift registers, eg for tests or with an InputReplay.
+ *
+ * @details The inputs are numbered as they appear in a ShiftRegisterInputBank with the default MSBFIRST
+ * bit order: input <code>length - 1</code> is clocked out first. So for 74HC165s, input n is D(n % 8) of
+ * register <code>chips - 1 - n / 8</code>, where register 0 is nearest the Arduino.
+ */
+class VirtualShiftRegisterChain : public ShiftRegisterLines {
+
+    public:
+
+    /**
+     * @brief Construct a chain of up to 64 bits.
+     */
+    VirtualShiftRegisterChain(uint8_t length)
+    : length(length < 64 ? length : 64) {}
+
+    void load() override {
+        chain = inputs;
+        loads++;
+    }
+
+    bool data() override {
+        return length ? (chain >> (length - 1)) & 1 : false;
+    }
+
+    void clock() override {
+        chain <<= 1; // The serial input of the last register is tied LOW
+        clocks++;
+    }
+
+    /**
+     * @brief Set the level of one parallel input.
+     */
+    void setInput(uint8_t input, bool level) {
+        if ( input >= length ) return;
+        if ( level ) {
+            inputs |= (uint64_t)1 << input;
+        } else {
+            inputs &= ~((uint64_t)1 << input);
+        }
+    }
+
+    /**
+     * @brief Set the levels of all the parallel inputs.
+     */
+    void setInputs(uint64_t levels) { inputs = levels; }
+
+    /**
+     * @brief The levels of the parallel inputs.
+     */
+    uint64_t getInputs() { return inputs; }
+
+    /**
+     * @brief The number of times the chain has been loaded (ie read).
+     */
+    uint32_t loadCount() { return loads; }
+
+    /**
+     * @brief The number of clock pulses.
+     */
+    uint32_t clockCount() { return clocks; }
+
+    private:
+    uint8_t length;
+    uint64_t inputs = 0;
+    uint64_t chain = 0;
+    uint32_t loads = 0;
+    uint32_t clocks = 0;
+};
+
+/**
+ * @brief Clocks in a chain of shift registers (eg 74HC165) once per scan and gives out a PinAdapter for each bit.
+ *
+ * @details A chain of 8 74HC165s is 64 inputs for three pins. Each scan latches the inputs and clocks the whole
+ * chain into a mask once, however many of its pins are read - a BasicPortSnapshot of the chain. Pass the PinAdapter
+ * from pin(n) to an EventButton or EventSwitch, or to a BasicBankDebounceAdapter via its read function:
+ *
+ * ```cpp
+ * GpioShiftRegisterLines lines(8, 9, 10); // load, clock, data
+ * ShiftRegisterInputBank16 bank(&lines, 16); // Two 74HC165s
+ * EventButton button(bank.pin(3));
+ * ```
+ *
+ * With the default MSBFIRST bit order the first bit clocked out is bit <code>length - 1</code>, so for a single
+ * 74HC165 bit n is input Dn and in a chain the register nearest the Arduino is the most significant byte.
+ * With LSBFIRST the first bit clocked out is bit 0.
+ *
+ * @tparam MaskT uint8_t, uint16_t, uint32_t or uint64_t
+ */
+template <class MaskT>
+class BasicShiftRegisterInputBank : public BasicPortSnapshot<MaskT, BasicShiftRegisterInputBank<MaskT>> {
+
+    typedef BasicPortSnapshot<MaskT, BasicShiftRegisterInputBank> Snapshot;
+
+    public:
+
+    /**
+     * @brief Construct a bank for a chain of shift registers.
+     *
+     * @param lines The load, clock and data lines of the chain
+     * @param length The number of bits in the chain, up to PINS (8 per 74HC165)
+     * @param bitOrder MSBFIRST (default) or LSBFIRST - where the first bit clocked out goes in the mask
+     */
+    BasicShiftRegisterInputBank(ShiftRegisterLines* lines, uint8_t length = Snapshot::PINS, uint8_t bitOrder = MSBFIRST)
+    : lines(lines),
+      length(length < Snapshot::PINS ? length : Snapshot::PINS),
+      msbFirst(bitOrder == MSBFIRST)
+    {}
+
+    /**
+     * @brief Set the pin modes of the lines and take the first snapshot. Call from <code>setup()</code>.
+     */
+    void begin() {
+        lines->begin();
+        this->refresh();
+    }
+
+    /**
+     * @brief The number of bits in the chain.
+     */
+    uint8_t getLength() { return length; }
+
+    protected:
+
+    friend class BasicPortSnapshot<MaskT, BasicShiftRegisterInputBank>;
+
+    /**
+     * @brief Latch the inputs and clock the chain into a mask. Called by refresh().
+     */
+    MaskT readSnapshot() {
+        MaskT value = 0;
+        lines->load();
+        for ( uint8_t i = 0; i < length; i++ ) {
+            bool bit = lines->data();
+            if ( msbFirst ) {
+                value = (MaskT)(value << 1) | bit;
+            } else if ( bit ) {
+                value |= (MaskT)1 << i;
+            }
+            lines->clock();
+        }
+        return value;
+    }
+
+    private:
+    ShiftRegisterLines* lines;
+    uint8_t length;
+    bool msbFirst;
+
+};
+
+/**
+ * @brief A BasicShiftRegisterInputBank for one 74HC165 (8 inputs).
+ */
+typedef BasicShiftRegisterInputBank<uint8_t> ShiftRegisterInputBank8;
+
+/**
+ * @brief A BasicShiftRegisterInputBank for up to 16 inputs.
+ */
+typedef BasicShiftRegisterInputBank<uint16_t> ShiftRegisterInputBank16;
+
+/**
+ * @brief A BasicShiftRegisterInputBank for up to 32 inputs.
+ */
+typedef BasicShiftRegisterInputBank<uint32_t> ShiftRegisterInputBank;
+
+/**
+ * @brief A BasicShiftRegisterInputBank for up to 64 inputs (eight 74HC165s).
+ */
+typedef BasicShiftRegisterInputBank<uint64_t> ShiftRegisterInputBank64;
+
+#endif
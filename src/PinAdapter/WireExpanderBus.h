@@ -0,0 +1,115 @@
+#ifndef WireExpanderBus_h
+#define WireExpanderBus_h
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "ExpanderInputBank.h"
+
+/**
+ * @brief An ExpanderBus for an MCP23017 on I2C. All 16 pins are inputs with pullups.
+ *
+ * @details The interrupt fires on any change and INTA and INTB are mirrored, so either can be used as the
+ * interrupt line of an ExpanderInputBank. The address pointer is left on GPIOA and toggles between GPIOA and
+ * GPIOB (IOCON.SEQOP), so readAll() is a single two byte read. Do not share the expander with other code.
+ */
+class Mcp23017Bus : public ExpanderBus {
+
+    public:
+
+    /**
+     * @brief Construct the bus.
+     *
+     * @param address The I2C address, 0x20 to 0x27
+     * @param wire The I2C bus, default Wire
+     */
+    Mcp23017Bus(uint8_t address = 0x20, TwoWire& wire = Wire)
+    : address(address), wire(wire) {}
+
+    void begin() override {
+        wire.begin();
+        writeRegister(IOCON, 0x60);  // MIRROR and SEQOP, with BANK 0 the pointer toggles between A and B
+        writePair(IODIRA, 0xFFFF);   // All inputs
+        writePair(GPPUA, 0xFFFF);    // Pullups
+        writePair(INTCONA, 0x0000);  // Interrupt on change from the previous value
+        writePair(GPINTENA, 0xFFFF); // Interrupt on every pin
+        wire.beginTransmission(address);
+        wire.write(GPIOA);
+        wire.endTransmission();
+    }
+
+    uint16_t readAll() override {
+        if ( wire.requestFrom(address, (uint8_t)2) != 2 ) return 0xFFFF;
+        uint8_t a = wire.read();
+        uint8_t b = wire.read();
+        return (uint16_t)(b << 8) | a;
+    }
+
+    private:
+
+    static const uint8_t IODIRA = 0x00;
+    static const uint8_t GPINTENA = 0x04;
+    static const uint8_t INTCONA = 0x08;
+    static const uint8_t IOCON = 0x0A;
+    static const uint8_t GPPUA = 0x0C;
+    static const uint8_t GPIOA = 0x12;
+
+    void writeRegister(uint8_t reg, uint8_t value) {
+        wire.beginTransmission(address);
+        wire.write(reg);
+        wire.write(value);
+        wire.endTransmission();
+    }
+
+    void writePair(uint8_t regA, uint16_t value) {
+        wire.beginTransmission(address);
+        wire.write(regA);
+        wire.write((uint8_t)(value & 0xFF));
+        wire.write((uint8_t)(value >> 8));
+        wire.endTransmission();
+    }
+
+    uint8_t address;
+    TwoWire& wire;
+};
+
+/**
+ * @brief An ExpanderBus for a PCF8574 (8 pins) or PCF8575 (16 pins) on I2C.
+ *
+ * @details begin() writes all the pins HIGH, so they are weakly pulled up inputs. Its INT line is asserted on
+ * any change and cleared by readAll(), which is a single one or two byte read.
+ */
+class Pcf8574Bus : public ExpanderBus {
+
+    public:
+
+    /**
+     * @brief Construct the bus.
+     *
+     * @param address The I2C address, 0x20 to 0x27 (PCF8574A 0x38 to 0x3F)
+     * @param ports 1 for a PCF8574, 2 for a PCF8575
+     * @param wire The I2C bus, default Wire
+     */
+    Pcf8574Bus(uint8_t address = 0x20, uint8_t ports = 1, TwoWire& wire = Wire)
+    : address(address), ports(ports == 2 ? 2 : 1), wire(wire) {}
+
+    void begin() override {
+        wire.begin();
+        wire.beginTransmission(address);
+        for ( uint8_t i = 0; i < ports; i++ ) wire.write((uint8_t)0xFF);
+        wire.endTransmission();
+    }
+
+    uint16_t readAll() override {
+        if ( wire.requestFrom(address, ports) != ports ) return 0xFFFF;
+        uint16_t value = wire.read();
+        if ( ports == 2 ) value |= (uint16_t)wire.read() << 8;
+        return value;
+    }
+
+    private:
+    uint8_t address;
+    uint8_t ports;
+    TwoWire& wire;
+};
+
+#endif
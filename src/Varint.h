@@ -0,0 +1,69 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Map a signed value to an unsigned one so small negative values stay small (0, -1, 1, -2 ... become 0, 1, 2, 3 ...).
+ */
+inline uint32_t zigzagEncode(int32_t value) { return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31); }
+
+/**
+ * @brief Reverse zigzagEncode().
+ */
+inline int32_t zigzagDecode(uint32_t value) { return (int32_t)(value >> 1) ^ -(int32_t)(value & 1); }
+
+/**
+ * @brief The number of bytes writeVarint() needs for a value (1 to 5).
+ */
+inline uint8_t varintSize(uint32_t value) {
+    uint8_t n = 1;
+    while ( value >= 0x80 ) {
+        value >>= 7;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Write a value 7 bits per byte, least significant first, with the top bit set on all but the last byte.
+ * 
+ * @param out At least varintSize(value) bytes
+ * @return The number of bytes written
+ */
+inline uint8_t writeVarint(uint8_t* out, uint32_t value) {
+    uint8_t n = 0;
+    while ( value >= 0x80 ) {
+        out[n++] = (uint8_t)value | 0x80;
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+/**
+ * @brief Read a value written by writeVarint().
+ * 
+ * @param in The bytes
+ * @param length The number of bytes available
+ * @param value Set to the value
+ * @return The number of bytes read, 0 if the value is incomplete
+ */
+inline uint8_t readVarint(const uint8_t* in, size_t length, uint32_t& value) {
+    value = 0;
+    for ( uint8_t n = 0; n < 5 && n < length; n++ ) {
+        value |= (uint32_t)(in[n] & 0x7F) << (7 * n);
+        if ( (in[n] & 0x80) == 0 ) return n + 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ * 
+ * Copyright (c) 2024 Philip Fletcher <philip.fletcher@stutchbury.com>
+ * 
+ */
+
+#include "InputEvents.h"
+
+#ifndef EXCLUDE_EVENT_ENCODER
+
+#ifndef VIRTUAL_ENCODER_ADAPTER_H
+#define VIRTUAL_ENCODER_ADAPTER_H
+
+#include <Arduino.h>
+#include <EncoderAdapter.h>
+
+/**
+ * @brief An EncoderAdapter whose position is set programmatically, eg by a test, benchmark or InputReplay.
+ */
+class VirtualEncoderAdapter : public EncoderAdapter {
+
+    public:
+
+    /**
+     * @brief Nothing to initialise.
+     */
+    void begin() {}
+
+    /**
+     * @brief Returns the position (in encoder counts).
+     */
+    int32_t getPosition() { return position; }
+
+    /**
+     * @brief Set the position (in encoder counts).
+     */
+    void setPosition(int32_t pos) { position = pos; }
+
+    /**
+     * @brief Move the position by a number of counts (negative to turn backwards).
+     */
+    void step(int32_t counts = 1) { position += counts; }
+
+    private:
+    int32_t position = 0;
+
+};
+
+#endif
+#endif